@@ -0,0 +1,141 @@
+#include "bitindex.h"
+#include "bitkern.h"
+#include "cerror.h"
+
+/* initial number of slots in hash table */
+static const size_t HASH_INIT_SLOTS = 1024;
+
+// BitIndex
+BitIndex * BitIndex::create(Strategy strategy) {
+	switch (strategy) {
+	case BitIndex::trie:	return new BitTrieIndex();
+	case BitIndex::hash:	return new BitHashIndex();
+	default: {
+		CError error(CErrorType::InvalidArguments, "BitIndex::create", 
+			"Unknown strategy: " + std::to_string((int)strategy));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	}
+}
+void BitIndex::report(std::ostream & out) const { report(strategy, get_statistics(), out); }
+void BitIndex::report(Strategy strategy, const Statistics & stat, std::ostream & out) {
+	double avg_probe = 0.0;
+	if (stat.vectors > 0) avg_probe = ((double)stat.probes) / stat.vectors;
+
+	out << (strategy == BitIndex::hash ? "hash" : "trie")
+		<< ":\tvectors = " << stat.vectors << "; distincts = " << stat.distincts
+		<< "; probes/vector = " << avg_probe << "; collisions = " << stat.collisions
+		<< "; max-probe = " << stat.max_probe << "; memory = " << stat.bytes << " bytes\n";
+}
+
+// BitTrieIndex
+void *& BitTrieIndex::insert_vector(const BitSeq & bits) {
+	size_t visits = tree.get_visits();
+	BitTrie * leaf = tree.insert_vector(bits);
+
+	visits = tree.get_visits() - visits;
+	statistics.vectors++; statistics.probes += visits;
+	if (visits > statistics.max_probe) statistics.max_probe = visits;
+	statistics.distincts = tree.get_leaf_number();
+	statistics.bytes = tree.get_memory();
+	return leaf->data;
+}
+void * BitTrieIndex::get_data(const BitSeq & bits) const {
+	BitTrie * leaf = tree.get_leaf(bits);
+	if (leaf == nullptr) return nullptr;
+	else return leaf->get_data();
+}
+
+// BitHashIndex
+BitHashIndex::BitHashIndex() : BitIndex(BitIndex::hash), slots(HASH_INIT_SLOTS), arena() {
+	for (size_t i = 0; i < slots.size(); i++) {
+		slots[i].hash = 0; slots[i].key = nullptr;
+	}
+	statistics.bytes = slots.size() * sizeof(Slot);
+}
+word BitHashIndex::hash_of(const BitSeq & bits) {
+	const word * words = bits.get_words();
+	BitSeq::size_t n = bits.word_number(), rest = bits.bit_number() % WORD_BITS;
+	word h = 0x9E3779B97F4A7C15ULL ^ bits.bit_number();
+	for (BitSeq::size_t i = 0; i < n; i++) {
+		word w = words[i];
+		if (i + 1 == n && rest != 0) 
+			w &= (((word)1) << rest) - 1;
+		h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 32;
+	}
+	h ^= h >> 29; h *= 0xC4CEB9FE1A85EC53ULL; h ^= h >> 32;
+	return h;
+}
+bool BitHashIndex::equals(const Key & key, const BitSeq & bits) {
+	if (key.bit_num != bits.bit_number()) return false;
+	else if (key.bit_num == 0) return true;
+
+	const word * words = bits.get_words();
+	BitSeq::size_t n = bits.word_number() - 1, rest = key.bit_num % WORD_BITS;
+	if (!BitKernel::get().equals(key.words, words, n))
+		return false;
+
+	word mask = (rest == 0) ? ~((word)0) : ((((word)1) << rest) - 1);
+	return ((key.words[n] ^ words[n]) & mask) == 0;
+}
+size_t BitHashIndex::locate(const BitSeq & bits, word h, size_t & probes) const {
+	size_t mask = slots.size() - 1;
+	size_t k = (size_t)h & mask; probes = 1;
+	while (slots[k].key != nullptr) {
+		if (slots[k].hash == h && equals(*(slots[k].key), bits))
+			break;
+		k = (k + 1) & mask; probes++;
+	}
+	return k;
+}
+void BitHashIndex::rehash() {
+	std::vector<Slot> old_slots(slots.size() * 2);
+	old_slots.swap(slots);
+
+	size_t mask = slots.size() - 1;
+	for (size_t i = 0; i < slots.size(); i++) {
+		slots[i].hash = 0; slots[i].key = nullptr;
+	}
+	for (size_t i = 0; i < old_slots.size(); i++) {
+		if (old_slots[i].key != nullptr) {
+			size_t k = (size_t)old_slots[i].hash & mask;
+			while (slots[k].key != nullptr) k = (k + 1) & mask;
+			slots[k] = old_slots[i];
+		}
+	}
+}
+void *& BitHashIndex::insert_vector(const BitSeq & bits) {
+	word h = hash_of(bits); size_t probes;
+	size_t k = locate(bits, h, probes);
+
+	statistics.vectors++; statistics.probes += probes; 
+	statistics.collisions += probes - 1;
+	if (probes > statistics.max_probe) statistics.max_probe = probes;
+
+	if (slots[k].key == nullptr) {
+		/* copy the sequence as a new key */
+		BitSeq::size_t n = bits.word_number();
+		Key * key = arena.create<Key>();
+		key->bit_num = bits.bit_number(); key->data = nullptr;
+		key->words = arena.create_array<word>(n);
+		const word * words = bits.get_words();
+		for (BitSeq::size_t i = 0; i < n; i++)
+			key->words[i] = words[i];
+
+		slots[k].hash = h; slots[k].key = key;
+		statistics.distincts++;
+
+		/* keep the load factor under 1/2 */
+		if (statistics.distincts * 2 > slots.size()) rehash();
+		statistics.bytes = slots.size() * sizeof(Slot) + arena.reserved_bytes();
+		return key->data;
+	}
+	else return slots[k].key->data;
+}
+void * BitHashIndex::get_data(const BitSeq & bits) const {
+	size_t probes;
+	size_t k = locate(bits, hash_of(bits), probes);
+	if (slots[k].key == nullptr) return nullptr;
+	else return slots[k].key->data;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+/*
+File: bitindex.h
+-Aim: to cluster identical bit sequences by trie or hash table
+-Dat: Oct 16th, 2026
+-Cls:
+[1] class BitIndex;
+[2] class BitTrieIndex;
+[3] class BitHashIndex;
+*/
+
+#include "bitseq.h"
+#include <iostream>
+#include <vector>
+
+class BitIndex;
+class BitTrieIndex;
+class BitHashIndex;
+
+/* index that maps each distinct bit-sequence to a data item */
+class BitIndex {
+public:
+	/* strategy to cluster bit sequences */
+	typedef char Strategy;
+	static const Strategy trie = 0;		/* binary trie matched word by word */
+	static const Strategy hash = 1;		/* open-addressing hash table confirmed by equals */
+
+	/* statistics of insertions into the index */
+	struct Statistics {
+		/* number of vectors inserted */
+		size_t vectors;
+		/* number of distinct vectors */
+		size_t distincts;
+		/* number of trie nodes or hash slots visited */
+		size_t probes;
+		/* number of hash slots visited but occupied by other vectors (0 for trie) */
+		size_t collisions;
+		/* maximum nodes or slots visited by one insertion */
+		size_t max_probe;
+		/* bytes allocated for nodes, slots and keys */
+		size_t bytes;
+	};
+
+	/* create an index of specified strategy */
+	static BitIndex * create(Strategy);
+	/* deconstructor */
+	virtual ~BitIndex() {}
+
+	/* get the strategy of this index */
+	Strategy get_strategy() const { return strategy; }
+	/*
+	*	get the data slot referred by the sequence, where a new slot (null)
+	*	is created when the sequence is not in index. The slot keeps valid
+	*	till the index is deleted.
+	*/
+	virtual void *& insert_vector(const BitSeq &) = 0;
+	/* get the data referred by the sequence (null if not in index) */
+	virtual void * get_data(const BitSeq &) const = 0;
+
+	/* get the statistics of insertions */
+	const Statistics & get_statistics() const { return statistics; }
+	/* print the statistics as one line */
+	void report(std::ostream &) const;
+	/* print the statistics as one line */
+	static void report(Strategy, const Statistics &, std::ostream &);
+
+protected:
+	/* create an empty index */
+	BitIndex(Strategy s) : strategy(s) { 
+		statistics.vectors = 0; statistics.distincts = 0; statistics.probes = 0;
+		statistics.collisions = 0; statistics.max_probe = 0; statistics.bytes = 0;
+	}
+	/* strategy of the index */
+	Strategy strategy;
+	/* statistics of insertions */
+	Statistics statistics;
+};
+/* index on BitTrieTree */
+class BitTrieIndex : public BitIndex {
+public:
+	/* create an empty trie */
+	BitTrieIndex() : BitIndex(BitIndex::trie), tree() {}
+	/* deconstructor */
+	~BitTrieIndex() {}
+
+	void *& insert_vector(const BitSeq &);
+	void * get_data(const BitSeq &) const;
+
+private:
+	/* trie where leafs keep the data */
+	BitTrieTree tree;
+};
+/* index on open-addressing (linear probing) hash table */
+class BitHashIndex : public BitIndex {
+public:
+	/* create an empty table */
+	BitHashIndex();
+	/* deconstructor */
+	~BitHashIndex() {}
+
+	void *& insert_vector(const BitSeq &);
+	void * get_data(const BitSeq &) const;
+
+private:
+	/* distinct sequence and its data, allocated in arena */
+	struct Key {
+		/* number of bits in sequence */
+		BitSeq::size_t bit_num;
+		/* copy of the words */
+		word * words;
+		/* data referred by sequence */
+		void * data;
+	};
+	/* slot in table (null key when empty) */
+	struct Slot {
+		word hash;
+		Key * key;
+	};
+
+	/* slots of which number is power of 2 */
+	std::vector<Slot> slots;
+	/* arena where keys are allocated */
+	MemoryArena arena;
+
+	/* hash over the (masked) words of sequence */
+	static word hash_of(const BitSeq &);
+	/* whether the key equals with the sequence */
+	static bool equals(const Key &, const BitSeq &);
+	/* find the slot of sequence, or the empty slot where it should be placed */
+	size_t locate(const BitSeq &, word, size_t &) const;
+	/* double the slots and re-insert keys */
+	void rehash();
+};
@@ -0,0 +1,389 @@
+#include "bitkern.h"
+#include <chrono>
+#include <iomanip>
+
+/* the vector kernels use 64-bit intrinsics, so 32-bit x86 keeps the scalar kernel */
+#if defined(_M_X64) || defined(__x86_64__)
+#define BITKERN_X64
+#endif
+
+#ifdef BITKERN_X64
+#if defined(_MSC_VER)
+#include <intrin.h>
+/* MSVC accepts intrinsics of any instruction set in any function */
+#define BITKERN_TARGET(isa)
+#else
+#include <immintrin.h>
+/* GCC | Clang compile the function for specified instruction set */
+#define BITKERN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+// scalar kernels
+static bool scalar_subsume(const word * x, const word * y, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		if ((x[i] & ~(y[i])) != 0) return false;
+	}
+	return true;
+}
+static bool scalar_equals(const word * x, const word * y, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		if (x[i] != y[i]) return false;
+	}
+	return true;
+}
+static void scalar_conjunct(word * x, const word * y, size_t n) {
+	for (size_t i = 0; i < n; i++) x[i] &= y[i];
+}
+static void scalar_disjunct(word * x, const word * y, size_t n) {
+	for (size_t i = 0; i < n; i++) x[i] |= y[i];
+}
+static void scalar_subtract(word * x, const word * y, size_t n) {
+	for (size_t i = 0; i < n; i++) x[i] &= ~(y[i]);
+}
+static size_t scalar_degree(const word * x, size_t n) {
+	size_t ones = 0;
+	for (size_t i = 0; i < n; i++) ones += word_degree(x[i]);
+	return ones;
+}
+/* append c bits to y, where acc keeps the fill (< 64) bits not yet stored */
+static inline void gather_push(word *& y, word & acc, unsigned int & fill, word bits, unsigned int c) {
+	acc |= bits << fill;
+	if (fill + c >= WORD_BITS) {
+		*(y++) = acc;
+		acc = (fill == 0) ? 0 : bits >> (WORD_BITS - fill);
+		fill = fill + c - WORD_BITS;
+	}
+	else fill += c;
+}
+static size_t scalar_gather(word * y, const word * x, const word * m, size_t n) {
+	word acc = 0; unsigned int fill = 0; size_t k = 0;
+	for (size_t i = 0; i < n; i++) {
+		word mask = m[i], bits = 0; unsigned int c = 0;
+		while (mask != 0) {
+			word low = mask & (~mask + 1);
+			if ((x[i] & low) != 0) bits |= ((word)1) << c;
+			mask ^= low; c++;
+		}
+		gather_push(y, acc, fill, bits, c); k += c;
+	}
+	if (fill > 0) *y = acc;
+	return k;
+}
+static const BitKernel scalar_kernel = {
+	"scalar", scalar_subsume, scalar_equals, scalar_conjunct,
+	scalar_disjunct, scalar_subtract, scalar_degree, scalar_gather,
+};
+
+#ifdef BITKERN_X64
+// SSE2 kernels (2 words per step)
+BITKERN_TARGET("sse2") static bool sse2_subsume(const word * x, const word * y, size_t n) {
+	size_t i = 0; const __m128i zero = _mm_setzero_si128();
+	for (; i + 2 <= n; i += 2) {
+		__m128i xi = _mm_loadu_si128((const __m128i *)(x + i));
+		__m128i yi = _mm_loadu_si128((const __m128i *)(y + i));
+		__m128i di = _mm_andnot_si128(yi, xi);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(di, zero)) != 0xFFFF) return false;
+	}
+	return scalar_subsume(x + i, y + i, n - i);
+}
+BITKERN_TARGET("sse2") static bool sse2_equals(const word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128i xi = _mm_loadu_si128((const __m128i *)(x + i));
+		__m128i yi = _mm_loadu_si128((const __m128i *)(y + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(xi, yi)) != 0xFFFF) return false;
+	}
+	return scalar_equals(x + i, y + i, n - i);
+}
+BITKERN_TARGET("sse2") static void sse2_conjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128i xi = _mm_loadu_si128((const __m128i *)(x + i));
+		__m128i yi = _mm_loadu_si128((const __m128i *)(y + i));
+		_mm_storeu_si128((__m128i *)(x + i), _mm_and_si128(xi, yi));
+	}
+	scalar_conjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("sse2") static void sse2_disjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128i xi = _mm_loadu_si128((const __m128i *)(x + i));
+		__m128i yi = _mm_loadu_si128((const __m128i *)(y + i));
+		_mm_storeu_si128((__m128i *)(x + i), _mm_or_si128(xi, yi));
+	}
+	scalar_disjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("sse2") static void sse2_subtract(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128i xi = _mm_loadu_si128((const __m128i *)(x + i));
+		__m128i yi = _mm_loadu_si128((const __m128i *)(y + i));
+		_mm_storeu_si128((__m128i *)(x + i), _mm_andnot_si128(yi, xi));
+	}
+	scalar_subtract(x + i, y + i, n - i);
+}
+/* SSE2 has no vector popcount, the scalar popcnt is the fastest here */
+static const BitKernel sse2_kernel = {
+	"sse2", sse2_subsume, sse2_equals, sse2_conjunct,
+	sse2_disjunct, sse2_subtract, scalar_degree, scalar_gather,
+};
+
+// BMI2 kernel (one PEXT per word)
+BITKERN_TARGET("bmi2,popcnt") static size_t bmi2_gather(word * y, const word * x, const word * m, size_t n) {
+	word acc = 0; unsigned int fill = 0; size_t k = 0;
+	for (size_t i = 0; i < n; i++) {
+		unsigned int c = (unsigned int)_mm_popcnt_u64(m[i]);
+		gather_push(y, acc, fill, _pext_u64(x[i], m[i]), c); k += c;
+	}
+	if (fill > 0) *y = acc;
+	return k;
+}
+
+// AVX2 kernels (4 words per step)
+BITKERN_TARGET("avx2") static bool avx2_subsume(const word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i yi = _mm256_loadu_si256((const __m256i *)(y + i));
+		if (!_mm256_testc_si256(yi, xi)) return false;	/* (~y & x) != 0 */
+	}
+	return scalar_subsume(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx2") static bool avx2_equals(const word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i yi = _mm256_loadu_si256((const __m256i *)(y + i));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(xi, yi)) != -1) return false;
+	}
+	return scalar_equals(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx2") static void avx2_conjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i yi = _mm256_loadu_si256((const __m256i *)(y + i));
+		_mm256_storeu_si256((__m256i *)(x + i), _mm256_and_si256(xi, yi));
+	}
+	scalar_conjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx2") static void avx2_disjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i yi = _mm256_loadu_si256((const __m256i *)(y + i));
+		_mm256_storeu_si256((__m256i *)(x + i), _mm256_or_si256(xi, yi));
+	}
+	scalar_disjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx2") static void avx2_subtract(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i yi = _mm256_loadu_si256((const __m256i *)(y + i));
+		_mm256_storeu_si256((__m256i *)(x + i), _mm256_andnot_si256(yi, xi));
+	}
+	scalar_subtract(x + i, y + i, n - i);
+}
+/* popcount by nibble lookup table (W. Mula) */
+BITKERN_TARGET("avx2") static size_t avx2_degree(const word * x, size_t n) {
+	const __m256i table = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	__m256i total = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xi = _mm256_loadu_si256((const __m256i *)(x + i));
+		__m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(xi, low));
+		__m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(xi, 4), low));
+		__m256i bytes = _mm256_add_epi8(lo, hi);
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+	}
+	word sums[4]; _mm256_storeu_si256((__m256i *)sums, total);
+	size_t ones = (size_t)(sums[0] + sums[1] + sums[2] + sums[3]);
+	return ones + scalar_degree(x + i, n - i);
+}
+static const BitKernel avx2_kernel = {
+	"avx2", avx2_subsume, avx2_equals, avx2_conjunct,
+	avx2_disjunct, avx2_subtract, avx2_degree, scalar_gather,
+};
+static const BitKernel avx2_bmi2_kernel = {
+	"avx2+bmi2", avx2_subsume, avx2_equals, avx2_conjunct,
+	avx2_disjunct, avx2_subtract, avx2_degree, bmi2_gather,
+};
+
+// AVX-512 kernels (8 words per step)
+/* ANDN with a full mask and the sum by store: GCC builds the unmasked forms on undefined registers */
+BITKERN_TARGET("avx512f") static bool avx512_subsume(const word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		__m512i yi = _mm512_loadu_si512((const void *)(y + i));
+		__m512i di = _mm512_maskz_andnot_epi64(0xFF, yi, xi);
+		if (_mm512_test_epi64_mask(di, di) != 0) return false;
+	}
+	return avx2_subsume(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx512f") static bool avx512_equals(const word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		__m512i yi = _mm512_loadu_si512((const void *)(y + i));
+		if (_mm512_cmpneq_epi64_mask(xi, yi) != 0) return false;
+	}
+	return avx2_equals(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx512f") static void avx512_conjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		__m512i yi = _mm512_loadu_si512((const void *)(y + i));
+		_mm512_storeu_si512((void *)(x + i), _mm512_and_si512(xi, yi));
+	}
+	scalar_conjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx512f") static void avx512_disjunct(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		__m512i yi = _mm512_loadu_si512((const void *)(y + i));
+		_mm512_storeu_si512((void *)(x + i), _mm512_or_si512(xi, yi));
+	}
+	scalar_disjunct(x + i, y + i, n - i);
+}
+BITKERN_TARGET("avx512f") static void avx512_subtract(word * x, const word * y, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		__m512i yi = _mm512_loadu_si512((const void *)(y + i));
+		_mm512_storeu_si512((void *)(x + i), _mm512_maskz_andnot_epi64(0xFF, yi, xi));
+	}
+	scalar_subtract(x + i, y + i, n - i);
+}
+/* popcount by VPOPCNTQ (Ice Lake and later) */
+BITKERN_TARGET("avx512f,avx512vpopcntdq") static size_t avx512_degree(const word * x, size_t n) {
+	__m512i total = _mm512_setzero_si512();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xi = _mm512_loadu_si512((const void *)(x + i));
+		total = _mm512_add_epi64(total, _mm512_popcnt_epi64(xi));
+	}
+	word sums[8]; _mm512_storeu_si512((void *)sums, total);
+	size_t ones = 0;
+	for (size_t k = 0; k < 8; k++) ones += (size_t)sums[k];
+	return ones + scalar_degree(x + i, n - i);
+}
+/* every processor of AVX-512 has BMI2 as well */
+static const BitKernel avx512_kernel = {
+	"avx512", avx512_subsume, avx512_equals, avx512_conjunct,
+	avx512_disjunct, avx512_subtract, avx2_degree, bmi2_gather,
+};
+static const BitKernel avx512_popcnt_kernel = {
+	"avx512+vpopcntdq", avx512_subsume, avx512_equals, avx512_conjunct,
+	avx512_disjunct, avx512_subtract, avx512_degree, bmi2_gather,
+};
+
+/* features of the processor (and OS support for its registers) */
+typedef struct {
+	bool sse2, avx2, avx512, avx512_popcnt, bmi2;
+} _CPUFeatures;
+static _CPUFeatures detect_features() {
+	_CPUFeatures features = { false, false, false, false, false };
+#if defined(_MSC_VER)
+	int info[4]; __cpuid(info, 0); int max_leaf = info[0];
+	bool amd = (info[1] == 0x68747541);			/* "Auth" of "AuthenticAMD" */
+	__cpuid(info, 1);
+	int family = ((info[0] >> 8) & 0xF) + ((info[0] >> 20) & 0xFF);
+	features.sse2 = (info[3] & (1 << 26)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+	bool ymm = avx && (xcr0 & 0x06) == 0x06;		/* XMM | YMM state */
+	bool zmm = ymm && (xcr0 & 0xE0) == 0xE0;		/* opmask | ZMM state */
+	if (max_leaf >= 7) {
+		__cpuidex(info, 7, 0);
+		features.avx2 = ymm && (info[1] & (1 << 5)) != 0;
+		features.avx512 = zmm && (info[1] & (1 << 16)) != 0;
+		features.avx512_popcnt = features.avx512 && (info[2] & (1 << 14)) != 0;
+		features.bmi2 = (info[1] & (1 << 8)) != 0;
+	}
+	/* PEXT is microcoded (hundreds of cycles) on AMD before Zen 3 */
+	if (amd && family < 0x19) features.bmi2 = false;
+#else
+	__builtin_cpu_init();
+	features.sse2 = __builtin_cpu_supports("sse2");
+	features.avx2 = __builtin_cpu_supports("avx2");
+	features.avx512 = __builtin_cpu_supports("avx512f");
+	features.avx512_popcnt = features.avx512 && __builtin_cpu_supports("avx512vpopcntdq");
+	features.bmi2 = __builtin_cpu_supports("bmi2")
+		&& !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+#endif
+	return features;
+}
+#endif
+
+void BitKernel::get_supported(std::vector<const BitKernel *> & kernels) {
+	kernels.clear(); kernels.push_back(&scalar_kernel);
+#ifdef BITKERN_X64
+	_CPUFeatures features = detect_features();
+	if (features.sse2) kernels.push_back(&sse2_kernel);
+	if (features.avx2) kernels.push_back(features.bmi2 ? &avx2_bmi2_kernel : &avx2_kernel);
+	if (features.avx512 && features.avx2 && features.bmi2) {
+		if (features.avx512_popcnt)
+			kernels.push_back(&avx512_popcnt_kernel);
+		else kernels.push_back(&avx512_kernel);
+	}
+#endif
+}
+
+const BitKernel * BitKernel::select() {
+	std::vector<const BitKernel *> kernels;
+	get_supported(kernels); return kernels.back();
+}
+/* scalar until the CPUID is checked at startup */
+const BitKernel * BitKernel::selected = &scalar_kernel;
+const bool BitKernel::initialized = ((BitKernel::selected = BitKernel::select()) != nullptr);
+
+void BitKernel::benchmark(std::ostream & out) {
+	typedef std::chrono::high_resolution_clock Clock;
+	const size_t n = 4096;				/* 32 KB per array (fits L1 | L2) */
+	const size_t rounds = 20000;
+
+	/* y is a superset of x, so that subsume | equals must scan all words */
+	std::vector<word> x(n), y(n), z(n);
+	word seed = 0x9E3779B97F4A7C15ULL;
+	for (size_t i = 0; i < n; i++) {
+		seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+		x[i] = seed & (seed >> 3); y[i] = x[i] | (seed >> 11);
+	}
+
+	std::vector<const BitKernel *> kernels; get_supported(kernels);
+	out << "kernel\tsubsume\tequals\tconjunct\tdisjunct\tsubtract\tdegree\tgather\t(GB/s)\n";
+	size_t sink = 0;
+	for (size_t k = 0; k < kernels.size(); k++) {
+		const BitKernel & kernel = *(kernels[k]);
+		out << kernel.name;
+		for (int op = 0; op < 7; op++) {
+			z = x; size_t streams = (op == 5) ? 1 : 2;
+			Clock::time_point beg = Clock::now();
+			for (size_t r = 0; r < rounds; r++) {
+				switch (op) {
+				case 0: sink += kernel.subsume(x.data(), y.data(), n); break;
+				case 1: sink += kernel.equals(x.data(), z.data(), n); break;
+				case 2: kernel.conjunct(z.data(), y.data(), n); break;
+				case 3: kernel.disjunct(z.data(), x.data(), n); break;
+				case 4: kernel.subtract(z.data(), x.data(), n); break;
+				case 5: sink += kernel.degree(x.data(), n); break;
+				default: sink += kernel.gather(z.data(), x.data(), y.data(), n); break;
+				}
+			}
+			double seconds = std::chrono::duration<double>(Clock::now() - beg).count();
+			double bytes = (double)rounds * n * sizeof(word) * streams;
+			out << "\t" << std::fixed << std::setprecision(2) << (bytes / seconds / 1e9);
+		}
+		out << "\n";
+	}
+	out << "(selected: " << get().name << "; checksum " << (sink + z[0] % 2) << ")" << std::endl;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+/*
+File: bitkern.h
+-Aim: to define word-level kernels (scalar | SSE2 | AVX2 | AVX-512, BMI2) for bit sequence
+-Dat: Oct 16th, 2026
+-Cls:
+[1] struct BitKernel;
+*/
+
+#include "bitseq.h"
+#include <iostream>
+#include <vector>
+
+/*
+*	Table of kernels over arrays of words, selected once at startup by CPUID.
+*	Each kernel works on n complete words; the caller masks the padding.
+*/
+struct BitKernel {
+	/* name of the instruction set, e.g. "avx2" */
+	const char * name;
+
+	/* whether (x[i] & ~y[i]) == 0 for all i < n */
+	bool(*subsume)(const word * x, const word * y, size_t n);
+	/* whether x[i] == y[i] for all i < n */
+	bool(*equals)(const word * x, const word * y, size_t n);
+	/* x[i] = x[i] & y[i] */
+	void(*conjunct)(word * x, const word * y, size_t n);
+	/* x[i] = x[i] | y[i] */
+	void(*disjunct)(word * x, const word * y, size_t n);
+	/* x[i] = x[i] & ~y[i] */
+	void(*subtract)(word * x, const word * y, size_t n);
+	/* number of bit-ones in x[0, n) */
+	size_t(*degree)(const word * x, size_t n);
+	/* pack the bits of x[i] where m[i] is 1 (i < n) in order into y, and return the number of bits */
+	size_t(*gather)(word * y, const word * x, const word * m, size_t n);
+
+	/* get the best kernel supported by this machine */
+	static const BitKernel & get() { return *selected; }
+	/* get all the kernels supported by this machine (scalar first) */
+	static void get_supported(std::vector<const BitKernel *> &);
+	/* measure the throughput (GB/s) of each supported kernel */
+	static void benchmark(std::ostream &);
+
+private:
+	/* kernel used by bit sequences */
+	static const BitKernel * selected;
+	/* whether the kernel has been selected by CPUID */
+	static const bool initialized;
+	/* select the best kernel supported by this machine */
+	static const BitKernel * select();
+};
@@ -0,0 +1,154 @@
+#include "bitmatrix.h"
+#include "cerror.h"
+#include "bitkern.h"
+
+BitMatrix::BitMatrix(size_t r, size_t c) : rows(r), columns(c), 
+	col_data(nullptr), transposed(false), postings(c), posted(c, false) {
+	rwords = (columns + WORD_BITS - 1) / WORD_BITS;
+	cwords = (rows + WORD_BITS - 1) / WORD_BITS;
+
+	size_t n = rows * rwords;
+	row_data = new word[n];
+	for (size_t i = 0; i < n; i++) row_data[i] = 0;
+}
+BitMatrix::~BitMatrix() {
+	delete[] row_data;
+	if (col_data != nullptr) delete[] col_data;
+}
+void BitMatrix::out_of_index(const char * method, size_t r, size_t c) const {
+	CError error(CErrorType::OutOfIndex, method, "Invalid index: (" + std::to_string(r) 
+		+ ", " + std::to_string(c) + ") in " + std::to_string(rows) + " x " + std::to_string(columns));
+	CErrorConsumer::consume(error); exit(CErrorType::OutOfIndex);
+}
+void BitMatrix::invalidate() {
+	if (transposed) {
+		transposed = false;
+		for (size_t c = 0; c < columns; c++) {
+			if (posted[c]) {
+				postings[c].clear(); posted[c] = false;
+			}
+		}
+	}
+}
+bit BitMatrix::get_bit(size_t r, size_t c) const {
+	if (r >= rows || c >= columns) out_of_index("BitMatrix::get_bit", r, c);
+	return ((row_data[r * rwords + c / WORD_BITS] >> (c % WORD_BITS)) & 1) != 0;
+}
+void BitMatrix::set_bit(size_t r, size_t c, bit val) {
+	if (r >= rows || c >= columns) out_of_index("BitMatrix::set_bit", r, c);
+	word & w = row_data[r * rwords + c / WORD_BITS];
+	word mask = ((word)1) << (c % WORD_BITS);
+	if (val) w |= mask; else w &= ~mask;
+
+	/* keep the column view consistent */
+	if (transposed) {
+		word & cw = col_data[c * cwords + r / WORD_BITS];
+		word cmask = ((word)1) << (r % WORD_BITS);
+		if (val) cw |= cmask; else cw &= ~cmask;
+		if (posted[c]) {
+			postings[c].clear(); posted[c] = false;
+		}
+	}
+}
+void BitMatrix::set_row(size_t r, const BitSeq & seq) {
+	if (r >= rows) out_of_index("BitMatrix::set_row", r, 0);
+
+	size_t bits = seq.bit_number();
+	if (bits > columns) bits = columns;
+	size_t n = bits / WORD_BITS, rest = bits % WORD_BITS, k;
+
+	word * row = row_data + r * rwords;
+	const word * src = seq.get_words();
+	for (k = 0; k < n; k++) row[k] = src[k];
+	if (rest > 0) {
+		row[k] = src[k] & ((((word)1) << rest) - 1); k++;
+	}
+	for (; k < rwords; k++) row[k] = 0;
+	invalidate();
+}
+const word * BitMatrix::get_row(size_t r) const {
+	if (r >= rows) out_of_index("BitMatrix::get_row", r, 0);
+	return row_data + r * rwords;
+}
+const word * BitMatrix::get_column(size_t c) const {
+	if (c >= columns) out_of_index("BitMatrix::get_column", 0, c);
+	if (!transposed) transpose();
+	return col_data + c * cwords;
+}
+const std::vector<unsigned int> & BitMatrix::get_posting(size_t c) const {
+	const word * column = get_column(c);
+	if (!posted[c]) {
+		std::vector<unsigned int> & list = postings[c];
+		for (size_t k = 0; k < cwords; k++) {
+			word w = column[k];
+			while (w != 0) {
+				list.push_back((unsigned int)(k * WORD_BITS + word_ctz(w)));
+				w &= w - 1;
+			}
+		}
+		posted[c] = true;
+	}
+	return postings[c];
+}
+void BitMatrix::transpose_block(word * a) {
+	/* swap the off-diagonal blocks of j x j bits recursively (j = 32, 16, ..., 1) */
+	word m = 0x00000000FFFFFFFFULL;
+	for (unsigned int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+		for (unsigned int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+			word t = ((a[k] >> j) ^ a[k | j]) & m;
+			a[k] ^= t << j;
+			a[k | j] ^= t;
+		}
+	}
+}
+void BitMatrix::transpose() const {
+	if (col_data == nullptr) col_data = new word[columns * cwords];
+
+	word block[64];
+	for (size_t bc = 0; bc < rwords; bc++) {			/* 64 columns */
+		size_t cn = columns - bc * WORD_BITS;
+		if (cn > WORD_BITS) cn = WORD_BITS;
+
+		for (size_t br = 0; br < cwords; br++) {		/* 64 rows */
+			size_t r0 = br * WORD_BITS, rn = rows - r0;
+			if (rn > WORD_BITS) rn = WORD_BITS;
+
+			size_t i;
+			for (i = 0; i < rn; i++) block[i] = row_data[(r0 + i) * rwords + bc];
+			for (; i < 64; i++) block[i] = 0;
+
+			transpose_block(block);
+
+			for (i = 0; i < cn; i++)
+				col_data[(bc * WORD_BITS + i) * cwords + br] = block[i];
+		}
+	}
+	transposed = true;
+}
+void BitMatrix::reduce_transitive(const std::vector<std::vector<unsigned int>> & next,
+	const std::vector<unsigned int> & order, std::vector<std::vector<unsigned int>> & direct) {
+	/* row x of reach is the vertices reachable from x */
+	size_t n = next.size(); BitMatrix reach(n, n);
+	const BitKernel & kernel = BitKernel::get();
+	direct.assign(n, std::vector<unsigned int>());
+
+	auto beg = order.begin(), end = order.end();
+	while (beg != end) {
+		unsigned int x = *(beg++);
+		word * row = reach.row_data + x * reach.rwords;
+		const std::vector<unsigned int> & nexts = next[x];
+
+		/* vertices reachable through those in next[x] */
+		for (size_t k = 0; k < nexts.size(); k++)
+			kernel.disjunct(row, reach.row_data + nexts[k] * reach.rwords, reach.rwords);
+
+		/* the others are direct (and reachable from x as well) */
+		for (size_t k = 0; k < nexts.size(); k++) {
+			unsigned int y = nexts[k];
+			word mask = ((word)1) << (y % WORD_BITS);
+			if ((row[y / WORD_BITS] & mask) == 0) {
+				direct[x].push_back(y); row[y / WORD_BITS] |= mask;
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+File: bitmatrix.h
+-Aim: to define a bit matrix with both row-major and column-major (transposed) views
+-Dat: Oct 16th, 2026
+-Cls:
+[1] class BitMatrix;
+*/
+
+#include "bitseq.h"
+#include <vector>
+
+class BitMatrix;
+
+/*
+*	Matrix of bits where each row is stored in word-aligned words.
+*	The column view is the transpose built by 64 x 64 blocks when first
+*	accessed after rows are updated; posting lists (rows where the bit is 1)
+*	are derived from the columns on demand.
+*/
+class BitMatrix {
+public:
+	/* create an all-zero matrix of specified rows and columns */
+	BitMatrix(size_t, size_t);
+	/* deconstructor */
+	~BitMatrix();
+
+	/* number of rows */
+	size_t row_number() const { return rows; }
+	/* number of columns */
+	size_t column_number() const { return columns; }
+	/* number of words in each row */
+	size_t row_words() const { return rwords; }
+	/* number of words in each column */
+	size_t column_words() const { return cwords; }
+
+	/* get the bit at (row, column) */
+	bit get_bit(size_t, size_t) const;
+	/* set the bit at (row, column) */
+	void set_bit(size_t, size_t, bit);
+	/* set the row by the first bits in sequence (the rest is cleared) */
+	void set_row(size_t, const BitSeq &);
+	/* get the words of the row */
+	const word * get_row(size_t) const;
+	/* get the words of the column (rows over row_number() are zeros) */
+	const word * get_column(size_t) const;
+	/* get the rows of which bit is 1 at the column, in increasing order */
+	const std::vector<unsigned int> & get_posting(size_t) const;
+
+	/* rebuild the column view from rows (done when columns are accessed) */
+	void transpose() const;
+	/* transpose the 64 x 64 block in place, where bit j in block[i] is (i, j) */
+	static void transpose_block(word *);
+	/*
+	*	reduce the DAG where next[x] lists vertices reachable from x (not only directly),
+	*	and order lists every vertex after all those reachable from it. Then direct[x]
+	*	is next[x] without those reachable from another one in next[x]. 
+	*/
+	static void reduce_transitive(const std::vector<std::vector<unsigned int>> & next,
+		const std::vector<unsigned int> & order, std::vector<std::vector<unsigned int>> & direct);
+
+private:
+	size_t rows, columns;
+	size_t rwords, cwords;
+	/* rows * rwords words for the rows */
+	word * row_data;
+	/* columns * cwords words for the columns (built lazily) */
+	mutable word * col_data;
+	/* whether the columns are consistent with rows */
+	mutable bool transposed;
+	/* posting list of each column */
+	mutable std::vector<std::vector<unsigned int>> postings;
+	/* whether the posting list of column has been built */
+	mutable std::vector<bool> posted;
+
+	/* report the invalid index at (row, column) and exit */
+	void out_of_index(const char *, size_t, size_t) const;
+	/* invalidate column view and posting lists */
+	void invalidate();
+};
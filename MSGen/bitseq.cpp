@@ -1,61 +1,156 @@
 #include "bitseq.h"
+#include "bitkern.h"
 #include "cerror.h"
-#include <queue>
 #include "ctext.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// word methods
+unsigned int word_degree(word w) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	return (unsigned int)__popcnt64(w);
+#elif defined(_MSC_VER)
+	return __popcnt((unsigned int)w) + __popcnt((unsigned int)(w >> 32));
+#else
+	return (unsigned int)__builtin_popcountll(w);
+#endif
+}
+unsigned int word_ctz(word w) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long k; _BitScanForward64(&k, w); return k;
+#elif defined(_MSC_VER)
+	unsigned long k;
+	if (_BitScanForward(&k, (unsigned long)w)) return k;
+	_BitScanForward(&k, (unsigned long)(w >> 32)); return k + 32;
+#else
+	return (unsigned int)__builtin_ctzll(w);
+#endif
+}
 
 // BitSeq 
-BitSeq::BitSeq(const BitSeq & seq) : bit_num(seq.bit_num), length(seq.length) {
-	bytes = nullptr;
-	if (seq.length > 0) {
-		bytes = new byte[seq.length];
-		for (int i = 0; i < seq.length; i++) {
-			bytes[i] = seq.bytes[i];
-		}
+BitSeq::BitSeq(const BitSeq & seq) : bit_num(seq.bit_num), length(seq.length), wlength(seq.wlength), borrowed(false) {
+	allocate();
+	for (size_t i = 0; i < wlength; i++) {
+		words[i] = seq.words[i];
 	}
 }
-BitSeq::BitSeq(BitSeq::size_t bitnum) : bit_num(bitnum) {
+BitSeq::BitSeq(BitSeq::size_t bitnum) : bit_num(bitnum), borrowed(false) {
 	length = bitnum / 8;
 	if (bitnum % 8 != 0) length++;
+	wlength = bitnum / WORD_BITS;
+	if (bitnum % WORD_BITS != 0) wlength++;
 
-	bytes = nullptr;
-	if (length > 0) {
-		bytes = new byte[length];
-		for (int i = 0; i < length; i++) {
-			bytes[i] = 0;
-		}
+	allocate();
+	for (size_t i = 0; i < wlength; i++) {
+		words[i] = 0;
 	}
 }
-BitSeq::~BitSeq() {
-	if (bytes != nullptr)
-		delete bytes;
+BitSeq::BitSeq(BitSeq::size_t bitnum, word * external) : bit_num(bitnum), borrowed(true) {
+	length = bitnum / 8;
+	if (bitnum % 8 != 0) length++;
+	wlength = bitnum / WORD_BITS;
+	if (bitnum % WORD_BITS != 0) wlength++;
+	words = external;
+}
+BitSeq::BitSeq(BitSeq::size_t bitnum, const word * external) : BitSeq(bitnum, const_cast<word *>(external)) {}
+word * BitSeq::copy_words(MemoryArena & arena, const BitSeq & seq) {
+	size_t n = seq.word_number();
+	word * words = arena.create_array<word>(n);
+	const word * src = seq.get_words();
+	for (size_t i = 0; i < n; i++)
+		words[i] = src[i];
+	return words;
+}
+BitSeq::BitSeq(BitSeq && seq) : bit_num(seq.bit_num), length(seq.length), wlength(seq.wlength), borrowed(seq.borrowed) {
+	if (seq.is_local()) {
+		words = local_words;
+		for (size_t i = 0; i < wlength; i++)
+			words[i] = seq.words[i];
+	}
+	else words = seq.words;
+
+	seq.bit_num = 0; seq.length = 0; seq.borrowed = false;
+	seq.wlength = 0; seq.words = seq.local_words;
+}
+BitSeq::~BitSeq() { release(); }
+BitSeq & BitSeq::operator = (const BitSeq & seq) {
+	if (this == &seq) return *this;
+	if (wlength != seq.wlength) {
+		release(); wlength = seq.wlength; allocate();
+	}	/* otherwise the (external) words are overwritten in place */
+	bit_num = seq.bit_num; length = seq.length;
+	for (size_t i = 0; i < wlength; i++)
+		words[i] = seq.words[i];
+	return *this;
+}
+BitSeq & BitSeq::operator = (BitSeq && seq) {
+	if (this == &seq) return *this;
+	release();
+	bit_num = seq.bit_num; length = seq.length; wlength = seq.wlength;
+	if (seq.is_local()) {
+		for (size_t i = 0; i < wlength; i++)
+			words[i] = seq.words[i];
+	}
+	else {
+		words = seq.words; borrowed = seq.borrowed;
+	}
+
+	seq.bit_num = 0; seq.length = 0; seq.borrowed = false;
+	seq.wlength = 0; seq.words = seq.local_words;
+	return *this;
+}
+void BitSeq::allocate() {
+	borrowed = false;
+	if (wlength <= BITSEQ_INLINE_WORDS)
+		words = local_words;
+	else words = new word[wlength];
+}
+void BitSeq::release() {
+	if (is_owned())
+		delete[] words;
+	words = local_words; borrowed = false;
+}
+word BitSeq::tail_mask() const {
+	size_t rest = bit_num % WORD_BITS;
+	if (rest == 0) return ~((word)0);
+	else return (((word)1) << rest) - 1;
+}
+word BitSeq::word_at(BitSeq::size_t index) const {
+	size_t k = index / WORD_BITS, rest = index % WORD_BITS;
+	if (k >= wlength) return 0;
+	else if (rest == 0) return words[k];
+	else {
+		word w = words[k] >> rest;
+		if (k + 1 < wlength) 
+			w |= words[k + 1] << (WORD_BITS - rest);
+		return w;
+	}
 }
 BitSeq::size_t BitSeq::bit_number() const { return bit_num; }
 bit BitSeq::get_bit(BitSeq::size_t index) const {
 	if (index >= bit_num)
 		throw "Invalid index: ", index, " ( limits = ", bit_num, " )";
 	else {
-		byte bk = bytes[index / 8];
-		return (bk & BIT_LOC[index % 8]) != 0;
+		word wk = words[index / WORD_BITS];
+		return ((wk >> (index % WORD_BITS)) & 1) != 0;
 	}
 }
 void BitSeq::set_bit(BitSeq::size_t index, bit val) {
 	if (index >= bit_num)
 		throw "Invalid index: ", index, " ( limits = ", bit_num, " )";
 	else {
-		byte bk = bytes[index / 8];
-		bit oval = ((bk & BIT_LOC[index % 8]) != 0);
-		if (oval != val)
-			bytes[index / 8] = bytes[index / 8] ^ BIT_LOC[index % 8];
+		word mask = ((word)1) << (index % WORD_BITS);
+		if (val) words[index / WORD_BITS] |= mask;
+		else words[index / WORD_BITS] &= ~mask;
 	}
 }
 std::string BitSeq::to_string() const {
-	std::string str;
-	for (int i = 0; i < length; i++) {
-		for (int j = 0; j < 8 && i * 8 + j < bit_num; j++) {
-			if ((bytes[i] & BIT_LOC[j]) != 0)
-				str += '1';
-			else str += '0';
-		}
+	std::string str; str.reserve(bit_num);
+	for (size_t i = 0; i < bit_num; i++) {
+		if (((words[i / WORD_BITS] >> (i % WORD_BITS)) & 1) != 0)
+			str += '1';
+		else str += '0';
 	}
 	return str;
 }
@@ -63,51 +158,74 @@ BitSeq BitSeq::subseq(BitSeq::size_t start, BitSeq::size_t end) const {
 	if (start > bit_num)
 		throw "Invalid index: ", start, " ( limits = ", bit_num, " )";
 	else if (end > bit_num)
-		"Invalid index: ", end, " ( limits = ", bit_num, " )";
+		throw "Invalid index: ", end, " ( limits = ", bit_num, " )";
 	else if (start > end)
-		"Invalid index: ", start, "; ", end;
+		throw "Invalid index: ", start, "; ", end;
 	else {
-		BitSeq seq(end - start); int k = 0;
-		while (start < end) {
-			bit obit = this->get_bit(start++);
-			seq.set_bit(k++, obit);
-		}
+		BitSeq seq(end - start);
+		seq.assign(*this, start, end);
 		return seq;
 	}
 }
 bool BitSeq::subsume(const BitSeq & y) const {
-	int n = (length < y.length) ? length : y.length;
-	for (int i = 0; i < n; i++) {
-		byte b1 = bytes[i];
-		byte b2 = y.bytes[i];
-		if (b1 != (b1 & b2)) return false;
+	/* only the common prefix of both sequences is compared */
+	size_t bits = (bit_num < y.bit_num) ? bit_num : y.bit_num;
+	size_t n = bits / WORD_BITS, rest = bits % WORD_BITS;
+	if (!BitKernel::get().subsume(words, y.words, n))
+		return false;
+	if (rest > 0) {
+		word mask = (((word)1) << rest) - 1;
+		if ((words[n] & ~(y.words[n]) & mask) != 0) 
+			return false;
 	}
 	return true;
 }
 bool BitSeq::equals(const BitSeq & seq) const {
 	if (bit_num != seq.bit_num) return false;
+	else if (wlength == 0) return true;
 	else {
-		for (int i = 0; i < length; i++)
-			if (bytes[i] != seq.bytes[i])
-				return false;
-		return true;
+		size_t n = wlength - 1;
+		if (!BitKernel::get().equals(words, seq.words, n))
+			return false;
+		return ((words[n] ^ seq.words[n]) & tail_mask()) == 0;
 	}
 }
 int BitSeq::byte_number() const { return length; }
-byte * BitSeq::get_bytes() const { return bytes; }
+byte * BitSeq::get_bytes() const { return (byte *)words; }
 void BitSeq::set_bytes(const byte * new_bytes, size_t size) {
 	size_t n = (length < size) ? length : size;
-	for (int i = 0; i < n; i++)
+	byte * bytes = get_bytes();
+	for (size_t i = 0; i < n; i++)
 		bytes[i] = new_bytes[i];
 }
 void BitSeq::clear_bytes() {
-	for (int i = 0; i < length; i++)
-		bytes[i] = 0;
+	for (size_t i = 0; i < wlength; i++)
+		words[i] = 0;
 }
 void BitSeq::assign(const BitSeq & seq) {
-	int bits = (bit_num < seq.bit_num) ? bit_num : seq.bit_num;
-	for (int i = 0; i < bits; i++)
-		this->set_bit(i, seq.get_bit(i));
+	size_t bits = (bit_num < seq.bit_num) ? bit_num : seq.bit_num;
+	size_t n = bits / WORD_BITS, rest = bits % WORD_BITS;
+	for (size_t i = 0; i < n; i++)
+		words[i] = seq.words[i];
+	if (rest > 0) {
+		word mask = (((word)1) << rest) - 1;
+		words[n] = (words[n] & ~mask) | (seq.words[n] & mask);
+	}
+}
+void BitSeq::assign(const BitSeq & seq, BitSeq::size_t start, BitSeq::size_t end) {
+	if (start > end || end > seq.bit_num)
+		throw "Invalid index: ", start, "; ", end;
+
+	size_t bits = end - start;
+	if (bits > bit_num) bits = bit_num;
+	size_t n = bits / WORD_BITS, rest = bits % WORD_BITS;
+	for (size_t i = 0; i < n; i++)
+		words[i] = seq.word_at(start + i * WORD_BITS);
+	if (rest > 0) {
+		word mask = (((word)1) << rest) - 1;
+		word w = seq.word_at(start + n * WORD_BITS);
+		words[n] = (words[n] & ~mask) | (w & mask);
+	}
 }
 void BitSeq::conjunct(const BitSeq & y) {
 	if (this->bit_num != y.bit_num) {
@@ -116,8 +234,7 @@ void BitSeq::conjunct(const BitSeq & y) {
 		CErrorConsumer::consume(error);
 	}
 	else {
-		for (int i = 0; i < length; i++) 
-			bytes[i] = (bytes[i] & (y.bytes)[i]);
+		BitKernel::get().conjunct(words, y.words, wlength);
 	}
 }
 void BitSeq::disjunct(const BitSeq & y) {
@@ -127,51 +244,64 @@ void BitSeq::disjunct(const BitSeq & y) {
 		CErrorConsumer::consume(error);
 	}
 	else {
-		for (int i = 0; i < length; i++)
-			bytes[i] = (bytes[i] | (y.bytes)[i]);
+		BitKernel::get().disjunct(words, y.words, wlength);
+	}
+}
+void BitSeq::subtract(const BitSeq & y) {
+	if (this->bit_num != y.bit_num) {
+		CError error(CErrorType::InvalidArguments, "BitSeq::subtract", "Lenght is not matched: ("
+			+ std::to_string(bit_num) + " <--> " + std::to_string(y.bit_num) + ")");
+		CErrorConsumer::consume(error);
+	}
+	else {
+		BitKernel::get().subtract(words, y.words, wlength);
 	}
 }
 void BitSeq::bit_not() {
-	for (int i = 0; i < length; i++)
-		bytes[i] = ~(bytes[i]);
+	for (size_t i = 0; i < wlength; i++)
+		words[i] = ~(words[i]);
+	if (wlength > 0) words[wlength - 1] &= tail_mask();
 }
 bool BitSeq::all_zeros() const {
-	for (int i = 0; i < length; i++) {
-		if (bytes[i] != '\0')
+	if (wlength == 0) return true;
+	size_t n = wlength - 1;
+	for (size_t i = 0; i < n; i++) {
+		if (words[i] != 0)
 			return false;
 	}
-	return true;
+	return (words[n] & tail_mask()) == 0;
 }
 BitSeq::size_t BitSeq::degree() const {
-	size_t ones = 0, k = 0;
-	while (k < bit_num) {
-		if (get_bit(k++) == BIT_1)
-			ones++;
-	}
-	return ones;
+	if (wlength == 0) return 0;
+	size_t n = wlength - 1;
+	size_t ones = (size_t)BitKernel::get().degree(words, n);
+	return ones + word_degree(words[n] & tail_mask());
 }
 void BitSeq::increase() {
-	byte inc = 1;
-	for (size_t k = 0; k < length; k++) {
-		if (inc == 1) {
-			bytes[k] += inc;
-			if (bytes[k] == 0)
-				inc = 1;
-			else inc = 0;
-		}
-		else break;
+	for (size_t k = 0; k < wlength; k++) {
+		if (++words[k] != 0) break;
 	}
+	if (wlength > 0) words[wlength - 1] &= tail_mask();
 }
 
 
 // BitTrie
-BitTrie::BitTrie(BitSeq::size_t bias_index, const BitSeq & partial_key)
-	: bias(bias_index), left(nullptr), right(nullptr), parent(nullptr), data(nullptr) {
-	key = new BitSeq(partial_key);
-}
-BitTrie::~BitTrie() { delete key; }
+BitTrie::BitTrie(const word * key_source, BitSeq::size_t bias_index, BitSeq::size_t key_length)
+	: bias(bias_index), length(key_length), source(key_source), 
+	left(nullptr), right(nullptr), parent(nullptr), data(nullptr) {}
 BitSeq::size_t BitTrie::get_bias() const { return bias; }
-const BitSeq & BitTrie::get_key() const { return *key; }
+BitSeq::size_t BitTrie::get_length() const { return length; }
+const word * BitTrie::get_source() const { return source; }
+bit BitTrie::get_key_bit(BitSeq::size_t i) const { 
+	BitSeq::size_t k = bias + i;
+	return ((source[k / WORD_BITS] >> (k % WORD_BITS)) & 1) != 0;
+}
+BitSeq BitTrie::get_key() const { 
+	BitSeq key(length);
+	for (BitSeq::size_t i = 0; i < length; i++)
+		key.set_bit(i, get_key_bit(i));
+	return key;
+}
 BitTrie * BitTrie::get_left() const { return left; }
 BitTrie * BitTrie::get_right() const { return right; }
 BitTrie * BitTrie::get_parent() const { return parent; }
@@ -214,41 +344,45 @@ void * BitTrie::get_data() const { return data; }
 void BitTrie::set_data(void * value) { data = value; }
 
 // BitTrieTree
-BitTrieTree::BitTrieTree() : root(nullptr) {}
-BitTrieTree::~BitTrieTree() {
-	std::queue<BitTrie *> queue;
-	if (root != nullptr) {
-		queue.push(root);
-		while (!queue.empty()) {
-			BitTrie * node = queue.front();
-			if (node->get_left() != nullptr) queue.push(node->get_left());
-			if (node->get_right() != nullptr) queue.push(node->get_right());
-			queue.pop(); delete node;
-		}
+BitTrieTree::BitTrieTree() : root(nullptr), arena(), leafs(0), visits(0) {}
+BitTrieTree::~BitTrieTree() {}
+BitTrie * BitTrieTree::get_root() const { return root; }
+BitSeq::size_t BitTrieTree::mismatch(const word * x, const word * y, BitSeq::size_t start, BitSeq::size_t end) {
+	if (start >= end) return end;
+
+	BitSeq::size_t k = start / WORD_BITS, last = (end - 1) / WORD_BITS;
+	word diff = (x[k] ^ y[k]) & ((~((word)0)) << (start % WORD_BITS));
+	while (k < last) {
+		if (diff != 0)
+			return k * WORD_BITS + word_ctz(diff);
+		diff = x[k + 1] ^ y[k + 1]; k++;
 	}
+
+	BitSeq::size_t rest = end % WORD_BITS;
+	if (rest != 0) diff &= (((word)1) << rest) - 1;
+	if (diff != 0) return k * WORD_BITS + word_ctz(diff);
+	else return end;
 }
-BitTrie * BitTrieTree::get_root() const { return root; }
 BitTrie * BitTrieTree::maximum_prefix_match(const BitSeq & seq, BitSeq::size_t & index) const {
 	// initialization 
 	index = 0; BitTrie * node = root, *next;
-	int i, seql, keyl; bit seqi, keyi;
+	BitSeq::size_t seql, keye, limit; bit seqi;
 
 	// match from 0 to specific node
 	seql = seq.bit_number();
+	const word * words = seq.get_words();
 	while (node != nullptr) {
-		/* match the bits in current node.key */
-		keyl = (node->get_key()).bit_number();
-		for (i = 0; i < keyl && index < seql; i++, index++) {
-			seqi = seq.get_bit(index);
-			keyi = (node->get_key()).get_bit(i);
-			if (seqi != keyi) { break; }
-		}
+		visits++;
+		/* match the bits in current node.key word by word */
+		keye = node->bias + node->length;
+		limit = (keye < seql) ? keye : seql;
+		index = mismatch(words, node->source, index, limit);
 
 		/* not all-matched for this node or all-matched */
-		if (i < keyl || index >= seql) break;
+		if (index < keye || index >= seql) break;
 		/* all-matched for this node but not completed, to the next level */
 		else {
-			seqi = seq.get_bit(index++);
+			seqi = ((words[index / WORD_BITS] >> (index % WORD_BITS)) & 1) != 0; index++;
 			if (seqi) next = node->get_right();
 			else next = node->get_left();
 
@@ -267,43 +401,30 @@ BitTrie * BitTrieTree::get_leaf(const BitSeq & seq) const {
 		return leaf;
 	else return nullptr;
 }
+const word * BitTrieTree::copy_words(const BitSeq & seq) {
+	return BitSeq::copy_words(arena, seq);
+}
 BitTrie * BitTrieTree::insert_vector(const BitSeq & seq) {
 	if (root == nullptr) {
-		root = new BitTrie(0, seq);
-		return root;
+		root = arena.create<BitTrie>(copy_words(seq), 0, seq.bit_number());
+		leafs++; return root;
 	}
 	else {
 		BitSeq::size_t index, bit_num = seq.bit_number();
 		BitTrie * node = maximum_prefix_match(seq, index);
 		if (index >= bit_num) return node;
 
-		// get N, P, C1, C2
+		/*
+		*	split N into N1 (prev) and N (as post) at index, where
+		*	N1 views the same source as N, and L views a copy of seq in arena.
+		*/
 		BitTrie * parent = node->get_parent();
-		BitTrie * lchild = node->get_left();
-		BitTrie * rchild = node->get_right();
-
-		// create prev, ori_post, new_post
-		const BitSeq & key = node->get_key();
-		BitSeq::size_t bias = index - (node->get_bias());
-		BitSeq prev = key.subseq(0, bias);
-		BitSeq ori_post = key.subseq(bias + 1, key.bit_number());
-		BitSeq new_post = seq.subseq(index + 1, seq.bit_number());
+		BitSeq::size_t node_end = node->bias + node->length;
 		bit branch = seq.get_bit(index);
 
-		// create N1, N2, L
-		BitTrie * prev_node = new BitTrie(node->get_bias(), prev);
-		BitTrie * post_node = new BitTrie(index + 1, ori_post);
-		BitTrie * new_leaf = new BitTrie(index + 1, new_post);
-
-		// connect N1 to N2 and L
-		if (branch) {
-			prev_node->set_left(post_node);
-			prev_node->set_right(new_leaf);
-		}
-		else {
-			prev_node->set_left(new_leaf);
-			prev_node->set_right(post_node);
-		}
+		// create N1 and L
+		BitTrie * prev_node = arena.create<BitTrie>(node->source, node->bias, index - node->bias);
+		BitTrie * new_leaf = arena.create<BitTrie>(copy_words(seq), index + 1, bit_num - index - 1);
 
 		// connect N1 to P
 		if (parent != nullptr) {
@@ -312,23 +433,24 @@ BitTrie * BitTrieTree::insert_vector(const BitSeq & seq) {
 			else
 				parent->set_right(prev_node);
 		}
+		else root = prev_node;
 
-		// connect N2 to C1 and C2
-		post_node->set_left(lchild);
-		post_node->set_right(rchild);
+		// N matches the rest of its original key (children and data are kept)
+		node->bias = index + 1;
+		node->length = node_end - index - 1;
 
-		// maintain the data
-		if (node->data != nullptr) {
-			post_node->data = node->data;
+		// connect N1 to N and L
+		if (branch) {
+			prev_node->set_left(node);
+			prev_node->set_right(new_leaf);
+		}
+		else {
+			prev_node->set_left(new_leaf);
+			prev_node->set_right(node);
 		}
-
-		// remove node and update tree
-		if (node == root)
-			root = prev_node;
-		delete node;
 
 		// return 
-		return new_leaf;
+		leafs++; return new_leaf;
 	}
 }
 
@@ -6,7 +6,7 @@ File: bitseq.h
 -Dat: Mar 12th, 2017
 -Art: Lin Huan
 -Cls:
-[0] bit, byte;
+[0] bit, byte, word;
 [1] class BitSeq;
 [2] class KillVector;
 [3] class BitTrie;
@@ -15,11 +15,14 @@ File: bitseq.h
 
 #include <string>
 #include <list> 
+#include "carena.h"
 
 /* a bit is either 0 (false) or 1 (true) */
 typedef bool bit;
 /* byte is a unsigned char (8bit) */
 typedef unsigned char byte;
+/* word is a unsigned 64-bit integer, the unit where bits are stored */
+typedef unsigned long long word;
 
 /* bit-0 is represented as false */
 static const bit BIT_0 = false;
@@ -27,6 +30,15 @@ static const bit BIT_0 = false;
 static const bit BIT_1 = true;
 /* used to mask to retrieve bit from bit sequence */
 static const byte BIT_LOC[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+/* number of bits in one word */
+static const unsigned int WORD_BITS = 64;
+/* number of bytes in one word */
+static const unsigned int WORD_BYTES = 8;
+
+/* number of words stored inside BitSeq without heap allocation (4 words = 256 bits) */
+#ifndef BITSEQ_INLINE_WORDS
+#define BITSEQ_INLINE_WORDS 4
+#endif
 
 // declarations
 class BitSeq;
@@ -34,7 +46,17 @@ class SetIndex;
 class BitTrie;
 class BitTrieTree;
 
-/* Sequence of bits */
+/* number of bit-ones in the word */
+extern unsigned int word_degree(word);
+/* index of the lowest bit-one in the word (should not be zero) */
+extern unsigned int word_ctz(word);
+
+/*
+*	Sequence of bits, stored in 64-bit words (ith bit at word[i / 64]).
+*	The bytes from get_bytes() alias the same words (little-endian), and
+*	the padding bits over bit_number() are ignored in comparisons.
+*	Sequences of at most BITSEQ_INLINE_WORDS words are kept in the object.
+*/
 class BitSeq {
 public:
 	/* integer to access bit in BitSeq */
@@ -42,11 +64,27 @@ public:
 
 	/* construct from another bit sequence */
 	BitSeq(const BitSeq &);
+	/* construct by taking over the words of another sequence (which becomes empty) */
+	BitSeq(BitSeq &&);
 	/* construct a all-zero bit sequence of specified length */
 	BitSeq(size_t);
+	/* 
+	*	construct a sequence of specified length over external words, which are
+	*	neither copied, cleared nor released and should be alive as long as it.
+	*/
+	BitSeq(size_t, word *);
+	/* construct a read-only view over external words as above, whose bits should not be changed */
+	BitSeq(size_t, const word *);
+	/* copy the words of sequence into arena, so that the copy can be viewed as above */
+	static word * copy_words(MemoryArena &, const BitSeq &);
 	/* release dynamically allocated bytes in the sequence */
 	~BitSeq();
 
+	/* copy the length and bits of another sequence */
+	BitSeq & operator = (const BitSeq &);
+	/* take over the length and words of another sequence (which becomes empty) */
+	BitSeq & operator = (BitSeq &&);
+
 	/* get the number of bits occupied by the sequence */
 	size_t bit_number() const;
 	/* get the ith bit from sequence */
@@ -59,6 +97,8 @@ public:
 
 	/* assign the bit-string with another */
 	void assign(const BitSeq &);
+	/* assign the first (end - start) bits with seq[start, end), word by word */
+	void assign(const BitSeq &, size_t, size_t);
 	/* whether this sequence subsumes another */
 	bool subsume(const BitSeq &) const;
 	/* whether two bit-string equals with each other */
@@ -71,6 +111,8 @@ public:
 	void conjunct(const BitSeq &);
 	/* compute x = x | y */
 	void disjunct(const BitSeq &); 
+	/* compute x = x & ~y */
+	void subtract(const BitSeq &);
 	/* negate all the bits in the sequence */
 	void bit_not();
 	/* increase by 1 */
@@ -88,6 +130,11 @@ public:
 	/* set all bytes as zeros */
 	void clear_bytes();
 
+	/* number of words occupied by this sequence */
+	size_t word_number() const { return wlength; }
+	/* sequence of words to store bit-sequence */
+	word * get_words() const { return words; }
+
 	/* get the sub-bit-sequence within given range */
 	BitSeq subseq(size_t, size_t) const;
 private:
@@ -95,8 +142,27 @@ private:
 	size_t bit_num;
 	/* length of bytes */
 	size_t length;
-	/* bytes where bits are maintained */
-	byte * bytes;
+	/* length of words */
+	size_t wlength;
+	/* words where bits are maintained (either local_words or on heap) */
+	word * words;
+	/* inline words for narrow sequence */
+	word local_words[BITSEQ_INLINE_WORDS];
+	/* whether the words are external and not released */
+	bool borrowed;
+
+	/* point words to local_words or to the heap for wlength words */
+	void allocate();
+	/* release the words on heap (if any) */
+	void release();
+	/* whether the words are stored inline */
+	bool is_local() const { return words == local_words; }
+	/* whether the words are allocated on heap by this sequence */
+	bool is_owned() const { return !borrowed && words != local_words; }
+	/* mask of the valid bits in the last word */
+	word tail_mask() const;
+	/* 64 bits starting from the specified bit (bits over the sequence are zeros) */
+	word word_at(size_t) const;
 };
 /* Binary trie for bit-sequence */
 class BitTrie {
@@ -106,15 +172,22 @@ protected:
 	/* set right child */
 	void set_right(BitTrie *);
 public:
-	/* construct a leaf node without data and children by specifying its start-index and key-sequence */
-	BitTrie(BitSeq::size_t, const BitSeq &);
-	/* release the key sequence (not data, left and right) */
-	~BitTrie();
+	/*
+	*	construct a leaf node without data and children, whose key is source[bias, bias + length).
+	*	The source words are not copied and should be alive as long as the node.
+	*/
+	BitTrie(const word *, BitSeq::size_t, BitSeq::size_t);
 
 	/* get the index to the first bit which it's going to match */
 	BitSeq::size_t get_bias() const;
-	/* get the key in this sequence */
-	const BitSeq & get_key() const;
+	/* get the number of bits in the key */
+	BitSeq::size_t get_length() const;
+	/* get the words where the key is viewed, as source[bias, bias + length) */
+	const word * get_source() const;
+	/* get the ith bit in the key */
+	bit get_key_bit(BitSeq::size_t) const;
+	/* get a copy of the key in this sequence */
+	BitSeq get_key() const;
 
 	/* get the left child */
 	BitTrie * get_left() const;
@@ -133,11 +206,14 @@ public:
 
 	/* friend class */
 	friend class BitTrieTree;
+	friend class BitTrieIndex;
 private:
 	/* index to the first bit matched by this node */
 	BitSeq::size_t bias;
-	/* partial key to match bit-sequence from index to index + key.bit_number() - 1 */
-	BitSeq * key;
+	/* number of bits matched by this node */
+	BitSeq::size_t length;
+	/* partial key to match bit-sequence as source[bias, bias + length) */
+	const word * source;
 	/* left child */
 	BitTrie * left;
 	/* right child */
@@ -152,7 +228,7 @@ class BitTrieTree {
 public:
 	/* construct an empty trie tree */
 	BitTrieTree();
-	/* release all trie nodes in the tree */
+	/* release all trie nodes and keys in the tree at once */
 	~BitTrieTree();
 
 	/* get the root of the tree (null when tree is empty) */
@@ -166,9 +242,26 @@ public:
 	/* get the leaf referring to the bit-sequence */
 	BitTrie * get_leaf(const BitSeq &) const;
 
+	/* number of leafs in the tree */
+	size_t get_leaf_number() const { return leafs; }
+	/* number of nodes visited in matching since the tree was created */
+	size_t get_visits() const { return visits; }
+	/* bytes of blocks occupied by nodes and keys */
+	size_t get_memory() const { return arena.reserved_bytes(); }
+
 private:
 	/* the root of this tree */
 	BitTrie * root;
+	/* arena where nodes and the words of leaf keys are allocated */
+	MemoryArena arena;
+	/* number of leafs */
+	size_t leafs;
+	/* number of nodes visited in matching */
+	mutable size_t visits;
 	/* match to the maximum prefix of sequence in the trie */
 	BitTrie * maximum_prefix_match(const BitSeq &, BitSeq::size_t &) const;
+	/* copy the words of sequence into arena */
+	const word * copy_words(const BitSeq &);
+	/* index to the first bit in [start, end) where x and y differ (end if none) */
+	static BitSeq::size_t mismatch(const word *, const word *, BitSeq::size_t, BitSeq::size_t);
 };
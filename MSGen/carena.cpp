@@ -0,0 +1,45 @@
+#include "carena.h"
+
+/* blocks grow geometrically up to this size */
+static const size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+MemoryArena::MemoryArena(size_t block_size) : blocks(), sizes(),
+	cursor(nullptr), limit(nullptr), next_size(block_size), used(0), reserved(0) {
+	if (next_size < 64) next_size = 64;
+}
+MemoryArena::~MemoryArena() {
+	for (size_t i = 0; i < blocks.size(); i++)
+		delete[] blocks[i];
+}
+void MemoryArena::grow(size_t size) {
+	size_t bsize = next_size;
+	if (bsize < size) bsize = size;
+	char * block = new char[bsize];
+	blocks.push_back(block); sizes.push_back(bsize);
+	cursor = block; limit = block + bsize; reserved += bsize;
+
+	if (next_size < MAX_BLOCK_SIZE) next_size *= 2;
+}
+void * MemoryArena::allocate(size_t size, size_t align) {
+	size_t pad = (align - ((size_t)cursor & (align - 1))) & (align - 1);
+	if (cursor == nullptr || (size_t)(limit - cursor) < size + pad) {
+		grow(size + align);
+		pad = (align - ((size_t)cursor & (align - 1))) & (align - 1);
+	}
+	void * ptr = cursor + pad;
+	cursor += pad + size; used += size;
+	return ptr;
+}
+void MemoryArena::clear() {
+	if (blocks.empty()) return;
+
+	size_t n = blocks.size() - 1;
+	for (size_t i = 0; i < n; i++)
+		delete[] blocks[i];
+	char * block = blocks[n]; size_t bsize = sizes[n];
+	blocks.clear(); sizes.clear();
+	blocks.push_back(block); sizes.push_back(bsize);
+
+	cursor = block; limit = block + bsize;
+	used = 0; reserved = bsize;
+}
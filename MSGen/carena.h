@@ -0,0 +1,107 @@
+#pragma once
+
+/*
+-File : carena.h
+-Date : Oct 16th, 2026
+-Purp : to allocate many small objects from large blocks and release them at once
+-Clas :
+	[1] MemoryArena
+	[2] ArenaAllocator<T>
+*/
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+class MemoryArena;
+template<class T> class ArenaAllocator;
+
+/*
+*	Bump allocator over a list of blocks.
+*	Objects created in the arena are never destructed one by one;
+*	they are released together when the arena is cleared or deleted,
+*	hence they should not own resources out of the arena.
+*/
+class MemoryArena {
+public:
+	/* create an empty arena whose first block has the specified bytes */
+	MemoryArena(size_t block_size = 16 * 1024);
+	/* release all the blocks (destructors of objects are not called) */
+	~MemoryArena();
+
+	/* allocate bytes aligned to specified boundary (power of 2) */
+	void * allocate(size_t size, size_t align = alignof(std::max_align_t));
+	/* construct an object of T in the arena */
+	template<class T, class... Args> T * create(Args &&... args) {
+		return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+	/* allocate an uninitialized array of n T in the arena */
+	template<class T> T * create_array(size_t n) {
+		return (T *)allocate(sizeof(T) * n, alignof(T));
+	}
+
+	/* release all the objects, keeping the last block for reuse */
+	void clear();
+
+	/* number of bytes allocated by users */
+	size_t used_bytes() const { return used; }
+	/* number of bytes occupied by blocks */
+	size_t reserved_bytes() const { return reserved; }
+
+private:
+	/* blocks of memory (the last one is in use) */
+	std::vector<char *> blocks;
+	/* size of each block in blocks */
+	std::vector<size_t> sizes;
+	/* next free byte in the last block */
+	char * cursor;
+	/* end of the last block */
+	char * limit;
+	/* size of the next block */
+	size_t next_size;
+	/* bytes allocated by users */
+	size_t used;
+	/* bytes in all blocks */
+	size_t reserved;
+
+	/* append a block of at least the specified bytes */
+	void grow(size_t);
+
+	/* arena cannot be copied */
+	MemoryArena(const MemoryArena &) = delete;
+	MemoryArena & operator = (const MemoryArena &) = delete;
+};
+/*
+*	Allocator for standard containers in an arena, or on the heap when the arena is null.
+*	Memory from the arena is only returned when the arena is cleared, so the containers
+*	in arena can be dropped without being destructed.
+*/
+template<class T> class ArenaAllocator {
+public:
+	typedef T value_type;
+
+	/* allocate in the arena (on the heap if null) */
+	ArenaAllocator(MemoryArena * a = nullptr) : arena(a) {}
+	/* allocate other type in the same arena */
+	template<class U> ArenaAllocator(const ArenaAllocator<U> & other) : arena(other.get_arena()) {}
+
+	/* get the arena where memory is allocated (null for heap) */
+	MemoryArena * get_arena() const { return arena; }
+
+	/* allocate n uninitialized T */
+	T * allocate(size_t n) {
+		if (arena == nullptr) return (T *)::operator new(sizeof(T) * n);
+		else return arena->create_array<T>(n);
+	}
+	/* release the memory of n T (only on the heap) */
+	void deallocate(T * ptr, size_t) {
+		if (arena == nullptr) ::operator delete(ptr);
+	}
+
+	template<class U> bool operator == (const ArenaAllocator<U> & other) const { return arena == other.get_arena(); }
+	template<class U> bool operator != (const ArenaAllocator<U> & other) const { return arena != other.get_arena(); }
+
+private:
+	MemoryArena * arena;
+};
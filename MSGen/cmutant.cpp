@@ -1,4 +1,5 @@
 #include "cmutant.h"
+#include <algorithm>
 
 const Mutation & Mutant::get_mutation(size_t k) const {
 	if (k >= orders) {
@@ -117,6 +118,12 @@ bool MutantSet::has_mutant(Mutant::ID mid) const {
 	else return vec.get_bit(mid) == BIT_1;
 }
 bool MutantSet::add_mutant(Mutant::ID mid) {
+	if (mid >= vec.bit_number() && mid < space.number_of_mutants()) {
+		/* mutants created in space after this set */
+		BitSeq bits(space.number_of_mutants());
+		bits.assign(vec); vec = std::move(bits);
+	}
+
 	if (vec.get_bit(mid) == BIT_1) return false;
 	else {
 		vec.set_bit(mid, BIT_1); number++;
@@ -124,13 +131,47 @@ bool MutantSet::add_mutant(Mutant::ID mid) {
 	}
 }
 bool MutantSet::del_mutant(Mutant::ID mid) {
-	if (vec.get_bit(mid) == BIT_0)
+	if (mid >= vec.bit_number() || vec.get_bit(mid) == BIT_0)
 		return false;
 	else {
 		number--; vec.set_bit(mid, BIT_0);
 		return true;
 	}
 }
+bool MutantList::has_mutant(Mutant::ID mid) const {
+	return std::binary_search(ids.begin(), ids.end(), mid);
+}
+bool MutantList::add_mutant(Mutant::ID mid) {
+	if (mid >= space.number_of_mutants()) {
+		CError error(CErrorType::InvalidArguments, "MutantList::add_mutant", 
+			"Invalid mutant-id (" + std::to_string(mid) + ")");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	else if (ids.empty() || ids.back() < mid) ids.push_back(mid);
+	else {
+		auto iter = std::lower_bound(ids.begin(), ids.end(), mid);
+		if (*iter == mid) return false;
+		else ids.insert(iter, mid);
+	}
+	release_set(); return true;
+}
+bool MutantList::del_mutant(Mutant::ID mid) {
+	auto iter = std::lower_bound(ids.begin(), ids.end(), mid);
+	if (iter == ids.end() || *iter != mid) return false;
+	else {
+		ids.erase(iter); release_set(); return true;
+	}
+}
+const MutantSet & MutantList::get_set() const {
+	if (set == nullptr) {
+		set = space.create_set();
+		for (size_t k = 0; k < ids.size(); k++) set->add_mutant(ids[k]);
+	}
+	return *set;
+}
+void MutantList::release_set() const {
+	if (set != nullptr) { space.delete_set(set); set = nullptr; }
+}
 bool MutantSet::complement() {
 	byte * bytes = vec.get_bytes();
 	int bnum = vec.byte_number();
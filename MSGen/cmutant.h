@@ -12,9 +12,11 @@
 [4] class MutantSource	(../muta/xxx/ for a source/preprocessed file)
 [5] class MutantSet		(subset of mutants in space)
 [6] class CMutant		(project to manage mutants in ../muta/{*})
+[7] class MutantList	(sorted ids of a few mutants in space)
 */
 
 #include "bitseq.h"
+#include "carena.h"
 #include "cfile.h"
 #include <map>
 
@@ -23,6 +25,7 @@ class Mutation;
 class Mutant;
 class MutantSpace;
 class MutantSet;
+class MutantList;
 class MutantSource;
 class CMutant;
 
@@ -191,7 +194,7 @@ public:
 
 	/* whether mutant of specified id in space belongs to this set */
 	bool has_mutant(Mutant::ID) const;
-	/* add a new mutant of space into this set */
+	/* add a new mutant of space into this set (which grows for mutants created after it) */
 	bool add_mutant(Mutant::ID);
 	/* delete an existing mutant from this set */
 	bool del_mutant(Mutant::ID);
@@ -245,6 +248,58 @@ private:
 	/* number of mutants in set */
 	size_t number;
 };
+/*
+*	Sub-set of mutants in space as their ids in increasing order, for small groups
+*	(e.g. clusters in graph) where a MutantSet as wide as the space is mostly zeros.
+*	The MutantSet of the same mutants is only created when it is required.
+*/
+class MutantList {
+public:
+	/* ids of mutants (in arena or on heap) */
+	typedef std::vector<Mutant::ID, ArenaAllocator<Mutant::ID>> IDs;
+
+	/* construct an empty list for mutants in the space, whose ids are kept in arena (on heap if null) */
+	MutantList(MutantSpace & spac, MemoryArena * arena = nullptr) : space(spac), 
+		ids(ArenaAllocator<Mutant::ID>(arena)), set(nullptr) {}
+	/* deconstructor */
+	~MutantList() { release_set(); }
+
+	/* get the space of mutants */
+	MutantSpace & get_space() const { return space; }
+	/* get the number of mutants in this list */
+	size_t number_of_mutants() const { return ids.size(); }
+	/* get the kth mutant in this list (in increasing order) */
+	Mutant::ID get_mutant(size_t k) const { return ids[k]; }
+	/* get the ids of mutants in increasing order */
+	const IDs & get_mutant_ids() const { return ids; }
+
+	/* whether mutant of specified id belongs to this list */
+	bool has_mutant(Mutant::ID) const;
+	/* add a mutant of space into this list */
+	bool add_mutant(Mutant::ID);
+	/* delete an existing mutant from this list */
+	bool del_mutant(Mutant::ID);
+	/* clear all the mutants in this list, and release the set created on demand (never in arena) */
+	void clear() { ids.clear(); release_set(); }
+
+	/* get the set of these mutants (created at the first call after update, not thread-safe) */
+	const MutantSet & get_set() const;
+
+private:
+	/* space where mutants are defined */
+	MutantSpace & space;
+	/* ids of mutants in increasing order */
+	IDs ids;
+	/* set of the same mutants (null until required) */
+	mutable MutantSet * set;
+
+	/* delete the set created for the mutants */
+	void release_set() const;
+
+	/* list cannot be copied */
+	MutantList(const MutantList &) = delete;
+	MutantList & operator = (const MutantList &) = delete;
+};
 
 /* loading mutant + mutations from mschema.txt for MutantSpace */
 class MutantLoader {
@@ -1,4 +1,8 @@
 #include "cscore.h"
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <new>
 
 bool ScoreVector::kill(TestCase::ID tid) {
 	const TestSet & tests = function.get_tests();
@@ -13,9 +17,41 @@ bool ScoreVector::kill(TestCase::ID tid) {
 	else return false;
 }
 
+ScoreBatch::ScoreBatch(const ScoreFunction & func, size_t n, bool rowed)
+	: function(func), bits(func.get_tests().size()), number(0), limit(n == 0 ? 1 : n) {
+	stride = (bits + WORD_BITS - 1) / WORD_BITS;
+	rows = rowed ? new word[limit * stride]() : nullptr;
+	vectors = (ScoreVector *)::operator new(limit * sizeof(ScoreVector));
+}
+ScoreBatch::~ScoreBatch() {
+	for (size_t k = 0; k < number; k++)
+		vectors[k].~ScoreVector();
+	::operator delete(vectors);
+	if (rows != nullptr) delete[] rows;
+}
+ScoreVector & ScoreBatch::append(Mutant::ID mid) {
+	ScoreVector * vec = new (vectors + number) 
+		ScoreVector(function, mid, bits, rows + number * stride);
+	number++; return *vec;
+}
+ScoreVector & ScoreBatch::append(Mutant::ID mid, const word * words) {
+	ScoreVector * vec = new (vectors + number) ScoreVector(function, mid, bits, words);
+	number++; return *vec;
+}
+ScoreVector & ScoreBatch::append(const ScoreVector & source) {
+	ScoreVector & vec = append(source.mid);
+	const word * words = (source.svec).get_words();
+	size_t n = (source.svec).word_number();
+	if (n > stride) n = stride;
+
+	word * row = (vec.svec).get_words();
+	for (size_t i = 0; i < n; i++) row[i] = words[i];
+	vec.degree = source.degree; return vec;
+}
+
 ScoreFunction::ScoreFunction(const ScoreSource & src, const TestSet & ts,
 	const MutantSet & ms) : source(src), tests(ts), mutants(ms), bid_tid(), tid_bid() {
-	const BitSeq & tvec = ms.get_set_vector();
+	const BitSeq & tvec = ts.get_set_vector();
 	BitSeq::size_t len = tvec.bit_number();
 	TestCase::ID tid = 0;
 
@@ -51,7 +87,33 @@ ScoreSource::ScoreSource(const CScore & p, const MutantSpace & ms, const File &
 		CError error(CErrorType::InvalidArguments, "ScoreSource::ScoreSource", "Invalid result file: " + rfile.get_path());
 		CErrorConsumer::consume(error);
 	}
+
+	/* ../score/xxx.txt --> ../score/xxx.bin */
+	const std::string & path = rfile.get_path();
+	if (endswith(path, ".txt"))
+		bpath = path.substr(0, path.length() - 4) + ".bin";
+	else bpath = path + ".bin";
+}
+bool ScoreSource::has_binary_file() const {
+	long long btime = last_modified(bpath);
+	if (btime < 0 || btime < last_modified(rfile.get_path())) return false;
+	/* truncated or stale files are ignored, and the text file is parsed instead */
+	return BinaryScoreProducer::validate(bpath, mspace.number_of_mutants(), tspace.number_of_tests());
 }
+bool ScoreSource::convert_to_binary() const {
+	return BinaryScoreProducer::convert(rfile.get_path(), bpath, 
+		mspace.number_of_mutants(), tspace.number_of_tests());
+}
+ScoreProducer * ScoreSource::create_producer(const ScoreFunction & func) const {
+	if (&(func.get_source()) != this) {
+		CError error(CErrorType::InvalidArguments, "ScoreSource::create_producer", "Function is not in source");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	else if (has_binary_file()) return new BinaryScoreProducer(func);
+	else if (ThreadPool::default_threads() > 1) return new ParallelScoreProducer(func);
+	else return new FileScoreProducer(func);
+}
+void ScoreSource::delete_producer(ScoreProducer * producer) const { delete producer; }
 ScoreSource::~ScoreSource() {
 	auto beg = function_pool.begin();
 	auto end = function_pool.end();
@@ -154,76 +216,434 @@ ScoreSource & CScore::get_source(const CodeFile & cfile) const {
 	return *(iter->second);
 }
 
-FileScoreProducer::FileScoreProducer(const ScoreFunction & func)
-	: function(func), reader(func.get_source().get_result_file().get_path()) {}
-ScoreVector * FileScoreProducer::produce() {
-	/* declarations */
-	std::string linestr, numstr; char ch;
-	TestCase::ID tid; Mutant::ID mid;
-	ScoreVector * ans = nullptr; int k, n;
-
-	/* get the next line to generate score vector */
-	while (reader.hasNext()) {
-		linestr = reader.next();	/* get next line */
-		k = 0, n = linestr.length();
-
-		/* get mutant id */
-		numstr = "";
+/* parse the integer as std::stoul over [beg, end) that has no spaces */
+static unsigned long parse_id(const char * beg, const char * end) {
+	unsigned long number = 0; bool negative = false;
+	if (beg < end && (*beg == '+' || *beg == '-')) {
+		negative = (*beg == '-'); beg++;
+	}
+	if (beg >= end || *beg < '0' || *beg > '9') {
+		CError error(CErrorType::InvalidArguments, "ScoreTextScanner::parse_id", 
+			"Invalid number: \"" + std::string(beg, end) + "\"");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	while (beg < end && *beg >= '0' && *beg <= '9')
+		number = number * 10 + (*(beg++) - '0');
+	return negative ? (0 - number) : number;
+}
+ScoreTextScanner::ScoreTextScanner(const std::string & path) : file(new MappedFile(path)), selection(nullptr) {
+	cursor = file->begin(); fend = file->end(); k = n = cursor;
+}
+ScoreTextScanner::ScoreTextScanner(const char * beg, const char * end) 
+	: file(nullptr), selection(nullptr), fend(end), cursor(beg), k(beg), n(beg) {}
+bool ScoreTextScanner::next_mutant(Mutant::ID & mid) {
+	char ch;
+	while (cursor < fend) {
+		/* next line in [k, n) */
+		k = cursor;
+		n = (const char *)memchr(k, '\n', fend - k);
+		if (n == nullptr) n = fend;
+		cursor = (n < fend) ? n + 1 : fend;
+
+		/* get mutant id from digits before '[' */
+		mid = 0; bool digits = false;
 		while (k < n) {
-			ch = linestr[k++];
+			ch = *(k++);
 			if (ch == '[') break;
-			else if (ch >= '0' && ch <= '9')
-				numstr += ch;
+			else if (ch >= '0' && ch <= '9') {
+				mid = mid * 10 + (ch - '0'); digits = true;
+			}
 		}
 		if (k >= n) continue;
-		mid = std::stoul(numstr);
-		ans = new ScoreVector(function, mid,
-			function.get_tests().size());
+		if (!digits) parse_id(k, k);	/* report empty id */
+
+		/* skip the test list of unselected mutant */
+		if (selection != nullptr && (mid >= selection->bit_number() 
+			|| selection->get_bit(mid) == BIT_0)) continue;
 
 		/* to the ':' */
 		while (k < n) {
-			ch = linestr[k++];
-			if (ch == ':') break;
+			if (*(k++) == ':') break;
 		}
+		return true;
+	}
+	k = n = fend; return false;
+}
+bool ScoreTextScanner::next_test(TestCase::ID & tid) {
+	if (k >= n) return false;
 
-		/* get test id from following list */
-		while (k < n) {
-			/* skip the 't' */
-			while (k < n) {
-				ch = linestr[k++];
-				if (ch == 't') break;
+	/* skip the 't' */
+	while (k < n) {
+		if (*(k++) == 't') break;
+	}
+	if (k >= n) return false;
+
+	/* get test id */
+	const char * num = k;
+	while (k < n && !is_space(*k)) k++;
+	tid = parse_id(num, k);
+	if (k < n) k++;
+	return true;
+}
+
+void ScoreProducer::set_selection(const BitSeq * bitmap) {
+	if (selection != nullptr) delete selection;
+	selection = (bitmap == nullptr) ? nullptr : new BitSeq(*bitmap);
+}
+ScoreBatch * ScoreProducer::produce_batch(size_t n) {
+	ScoreVector * vec = produce();
+	if (vec == nullptr) return nullptr;
+
+	ScoreBatch * batch = new ScoreBatch(vec->get_function(), n);
+	while (vec != nullptr) {
+		batch->append(*vec); delete vec;
+		vec = batch->full() ? nullptr : produce();
+	}
+	return batch;
+}
+
+FileScoreProducer::FileScoreProducer(const ScoreFunction & func)
+	: function(func), scanner(func.get_source().get_result_file().get_path()) {}
+ScoreVector * FileScoreProducer::produce() {
+	Mutant::ID mid; TestCase::ID tid;
+	if (!scanner.next_mutant(mid)) return nullptr;
+
+	ScoreVector * ans = new ScoreVector(function, mid,
+		function.get_tests().size());
+	while (scanner.next_test(tid)) 
+		ans->kill(tid);
+	return ans;
+}
+ScoreBatch * FileScoreProducer::produce_batch(size_t n) {
+	Mutant::ID mid; TestCase::ID tid;
+	if (!scanner.next_mutant(mid)) return nullptr;
+
+	ScoreBatch * batch = new ScoreBatch(function, n);
+	while (true) {
+		ScoreVector & vec = batch->append(mid);
+		while (scanner.next_test(tid)) vec.kill(tid);
+		if (batch->full() || !scanner.next_mutant(mid)) break;
+	}
+	return batch;
+}
+
+bool FileScoreProducer::select(const BitSeq * bitmap) {
+	set_selection(bitmap); scanner.set_selection(selection); return true;
+}
+
+ParallelScoreProducer::ParallelScoreProducer(const ScoreFunction & func, size_t threads, size_t chunk)
+	: function(func), file(func.get_source().get_result_file().get_path()), pool(threads), 
+	bounds(), window(), next_chunk(0), next_vector(0) {
+	/* split the file at the line ends after every chunk of bytes */
+	const char * beg = file.begin(), * fend = file.end();
+	if (chunk == 0) chunk = PARALLEL_SCORE_CHUNK;
+	bounds.push_back(beg);
+	while (beg < fend) {
+		const char * end = fend;
+		if ((size_t)(fend - beg) > chunk) {
+			end = (const char *)memchr(beg + chunk, '\n', fend - beg - chunk);
+			end = (end == nullptr) ? fend : end + 1;
+		}
+		bounds.push_back(end); beg = end;
+	}
+
+	/* two chunks for each worker keep them busy while the front one is produced */
+	window_size = pool.size() * 2;
+	fill_window();
+}
+ParallelScoreProducer::~ParallelScoreProducer() { drain_window(); }
+void ParallelScoreProducer::fill_window() {
+	while (window.size() < window_size && next_chunk + 1 < bounds.size()) {
+		Chunk * chunk = new Chunk();
+		chunk->beg = bounds[next_chunk];
+		chunk->end = bounds[next_chunk + 1];
+		chunk->done = pool.submit([this, chunk] { parse(*chunk); });
+		window.push_back(chunk); next_chunk++;
+	}
+}
+void ParallelScoreProducer::drain_window() {
+	bool front = true;
+	while (!window.empty()) {
+		Chunk * chunk = window.front(); window.pop_front();
+		chunk->done.wait();
+
+		size_t k = front ? next_vector : 0;
+		for (; k < chunk->vectors.size(); k++)
+			delete chunk->vectors[k];
+		delete chunk; front = false;
+	}
+	next_vector = 0;
+}
+void ParallelScoreProducer::parse(Chunk & chunk) {
+	ScoreTextScanner scanner(chunk.beg, chunk.end);
+	scanner.set_selection(selection);
+	Mutant::ID mid; TestCase::ID tid;
+	BitSeq::size_t tnum = function.get_tests().size();
+	while (scanner.next_mutant(mid)) {
+		ScoreVector * vec = new ScoreVector(function, mid, tnum);
+		while (scanner.next_test(tid)) vec->kill(tid);
+		chunk.vectors.push_back(vec);
+		chunk.ends.push_back(scanner.get_cursor());
+	}
+}
+ScoreVector * ParallelScoreProducer::produce() {
+	while (!window.empty()) {
+		Chunk * chunk = window.front();
+		chunk->done.wait();
+
+		if (next_vector < chunk->vectors.size())
+			return chunk->vectors[next_vector++];
+
+		/* the front chunk is exhausted */
+		window.pop_front(); delete chunk;
+		next_vector = 0; fill_window();
+	}
+	return nullptr;
+}
+bool ParallelScoreProducer::select(const BitSeq * bitmap) {
+	/* the chunks in window are parsed again from the line after the last vector produced */
+	if (!window.empty()) {
+		size_t first = next_chunk - window.size();
+		Chunk * front = window.front(); front->done.wait();
+		if (next_vector > 0) bounds[first] = front->ends[next_vector - 1];
+		drain_window(); next_chunk = first;
+	}
+	set_selection(bitmap); fill_window(); return true;
+}
+
+/* binary score file */
+static const char BINARY_SCORE_MAGIC[8] = { 'M', 'S', 'G', 'S', 'C', 'O', 'R', 'E' };
+static const unsigned int BINARY_SCORE_VERSION = 1;
+static const size_t BINARY_SCORE_HEADER = 32;
+/* whether the header (of BINARY_SCORE_HEADER bytes) matches a binary file of size bytes */
+static bool valid_binary_header(const char * data, size_t size) {
+	const unsigned int * header = (const unsigned int *)(data + 8);
+	if (memcmp(data, BINARY_SCORE_MAGIC, 8) != 0 || header[0] != BINARY_SCORE_VERSION) return false;
+
+	size_t mutants = header[1], tests = header[2], stride = header[3];
+	return stride == (tests + WORD_BITS - 1) / WORD_BITS && size == BINARY_SCORE_HEADER 
+		+ mutants * stride * WORD_BYTES + mutants * sizeof(unsigned int);
+}
+
+BinaryScoreProducer::BinaryScoreProducer(const ScoreFunction & func)
+	: function(func), file(func.get_source().get_binary_path()), cursor(0) {
+	/* validate the header and size */
+	const char * data = file.begin();
+	const unsigned int * header = (const unsigned int *)(data + 8);
+	if (file.size() < BINARY_SCORE_HEADER || !valid_binary_header(data, file.size())) {
+		CError error(CErrorType::InvalidArguments, "BinaryScoreProducer::BinaryScoreProducer", 
+			"Invalid binary file: " + func.get_source().get_binary_path());
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	mutants = header[1]; tests = header[2]; stride = header[3];
+
+	rows = (const word *)(data + BINARY_SCORE_HEADER);
+	degrees = (const unsigned int *)(rows + ((size_t)mutants) * stride);
+
+	/* rows are copied directly when bit k refers to test k */
+	const TestSet & tset = function.get_tests();
+	identity = (tset.size() == tests && function.number_of_bits() == tests);
+	for (TestCase::ID k = 0; identity && k < tests; k++)
+		identity = (function.get_test_id_at(k) == k);
+}
+ScoreVector * BinaryScoreProducer::produce(Mutant::ID mid) {
+	if (mid >= mutants || degrees[mid] == BINARY_SCORE_ABSENT) return nullptr;
+
+	ScoreVector * ans = new ScoreVector(function, mid,
+		function.get_tests().size());
+	load_row(*ans); return ans;
+}
+void BinaryScoreProducer::load_row(ScoreVector & vec) const {
+	const word * row = rows + ((size_t)vec.mid) * stride;
+	if (identity) {
+		word * words = (vec.svec).get_words();
+		for (unsigned int i = 0; i < stride; i++) 
+			words[i] = row[i];
+		vec.degree = degrees[vec.mid];
+	}
+	else {
+		for (unsigned int i = 0; i < stride; i++) {
+			word w = row[i];
+			while (w != 0) {
+				vec.kill(i * WORD_BITS + word_ctz(w));
+				w &= w - 1;
 			}
-			if (k >= n) break;
-
-			/* get test id */
-			numstr = "";
-			while (k < n) {
-				ch = linestr[k++];
-				if (is_space(ch)) break;
-				else numstr += ch;
+		}
+	}
+}
+ScoreVector * BinaryScoreProducer::produce() {
+	while (cursor < mutants) {
+		Mutant::ID mid = cursor++;
+		if (!is_selected(mid)) continue;
+
+		ScoreVector * ans = produce(mid);
+		if (ans != nullptr) return ans;
+	}
+	return nullptr;
+}
+ScoreBatch * BinaryScoreProducer::produce_batch(size_t n) {
+	ScoreBatch * batch = nullptr;
+	while (cursor < mutants) {
+		Mutant::ID mid = cursor++;
+		if (degrees[mid] == BINARY_SCORE_ABSENT || !is_selected(mid)) continue;
+
+		if (batch == nullptr) batch = new ScoreBatch(function, n);
+		load_row(batch->append(mid));
+		if (batch->full()) break;
+	}
+	return batch;
+}
+bool BinaryScoreProducer::select(const BitSeq * bitmap) { set_selection(bitmap); return true; }
+bool BinaryScoreProducer::convert(const std::string & txt, 
+	const std::string & bin, Mutant::ID mnum, TestCase::ID tnum) {
+	/* parse the text file into rows */
+	unsigned int stride = (tnum + WORD_BITS - 1) / WORD_BITS;
+	std::vector<word> rows(((size_t)mnum) * stride, 0);
+	std::vector<unsigned int> degrees(mnum, BINARY_SCORE_ABSENT);
+
+	ScoreTextScanner scanner(txt);
+	Mutant::ID mid; TestCase::ID tid;
+	while (scanner.next_mutant(mid)) {
+		if (mid >= mnum) {
+			CError error(CErrorType::OutOfIndex, "BinaryScoreProducer::convert", 
+				"Invalid mutant (" + std::to_string(mid) + ") in " + txt);
+			CErrorConsumer::consume(error); return false;
+		}
+		if (degrees[mid] == BINARY_SCORE_ABSENT) degrees[mid] = 0;
+
+		word * row = rows.data() + ((size_t)mid) * stride;
+		while (scanner.next_test(tid)) {
+			/* tests out of the space are ignored, as ScoreVector::kill does */
+			if (tid >= tnum) continue;
+			word mask = ((word)1) << (tid % WORD_BITS);
+			if ((row[tid / WORD_BITS] & mask) == 0) {
+				row[tid / WORD_BITS] |= mask; degrees[mid]++;
 			}
-			tid = std::stoul(numstr);
+		}
+	}
 
-			/* kill by the test */
-			ans->kill(tid);
-		} /* end for all test id */
+	/* write header, rows and degrees into a temporary file */
+	std::string temp = bin + ".tmp";
+	std::ofstream out(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!out) {
+		CError error(CErrorType::InvalidArguments, "BinaryScoreProducer::convert", "Cannot write: " + temp);
+		CErrorConsumer::consume(error); return false;
+	}
+	unsigned int header[6] = { BINARY_SCORE_VERSION, mnum, tnum, stride, 0, 0 };
+	out.write(BINARY_SCORE_MAGIC, 8);
+	out.write((const char *)header, sizeof(header));
+	out.write((const char *)rows.data(), rows.size() * WORD_BYTES);
+	out.write((const char *)degrees.data(), degrees.size() * sizeof(unsigned int));
+	out.close(); 
+	if (out.fail()) { std::remove(temp.c_str()); return false; }
 
-		break;
+	/* move it into place (rename cannot replace an existing file on Windows) */
+	std::remove(bin.c_str());
+	if (std::rename(temp.c_str(), bin.c_str()) != 0) {
+		CError error(CErrorType::InvalidArguments, "BinaryScoreProducer::convert", "Cannot write: " + bin);
+		CErrorConsumer::consume(error); std::remove(temp.c_str()); return false;
 	}
+	return true;
+}
+bool BinaryScoreProducer::validate(const std::string & bin, Mutant::ID mnum, TestCase::ID tnum) {
+	std::ifstream in(bin, std::ios::in | std::ios::binary);
+	if (!in) return false;
+	in.seekg(0, std::ios::end); size_t size = (size_t)in.tellg(); in.seekg(0, std::ios::beg);
+
+	unsigned int header[BINARY_SCORE_HEADER / sizeof(unsigned int)];
+	if (size < BINARY_SCORE_HEADER || !in.read((char *)header, BINARY_SCORE_HEADER)) return false;
+	else if (!valid_binary_header((const char *)header, size)) return false;
+	else return header[3] == mnum && header[4] == tnum;
+}
+PrefetchScoreProducer::PrefetchScoreProducer(ScoreProducer & prod, size_t capacity)
+	: producer(prod), queue(capacity), finished(false), stopping(false), statistics() {
+	worker = std::thread([this] { fetch(); });
+}
+PrefetchScoreProducer::~PrefetchScoreProducer() {
+	stopping.store(true, std::memory_order_release);
+	worker.join();
 
-	/* return */ return ans;
+	ScoreVector * vec;
+	while (queue.pop(vec)) delete vec;
+}
+void PrefetchScoreProducer::fetch() {
+	ScoreVector * vec;
+	while (!stopping.load(std::memory_order_acquire) 
+		&& (vec = producer.produce()) != nullptr) {
+		if (queue.push(vec)) continue;
+
+		/* queue is full: wait for the consumer */
+		auto start = std::chrono::steady_clock::now();
+		while (!queue.push(vec)) {
+			if (stopping.load(std::memory_order_acquire)) {
+				delete vec; break;
+			}
+			std::this_thread::yield();
+		}
+		statistics.producer_stall += std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+	finished.store(true, std::memory_order_release);
+}
+ScoreVector * PrefetchScoreProducer::produce() {
+	size_t depth = queue.size();
+	statistics.depth_sum += depth;
+	if (depth > statistics.max_depth) statistics.max_depth = depth;
+
+	ScoreVector * vec;
+	if (queue.pop(vec)) { statistics.vectors++; return vec; }
+
+	/* queue is empty: wait for the background thread */
+	auto start = std::chrono::steady_clock::now();
+	while (true) {
+		/* read finished before popping, so no vector pushed before it is lost */
+		bool done = finished.load(std::memory_order_acquire);
+		if (queue.pop(vec)) { statistics.vectors++; break; }
+		else if (done) { vec = nullptr; break; }
+		std::this_thread::yield();
+	}
+	statistics.consumer_stall += std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+	return vec;
+}
+void PrefetchScoreProducer::report(std::ostream & out) const {
+	double avg_depth = 0.0;
+	if (statistics.vectors > 0) avg_depth = ((double)statistics.depth_sum) / statistics.vectors;
+
+	out << "prefetch:\tvectors = " << statistics.vectors << "; capacity = " << queue.capacity()
+		<< "; depth/vector = " << avg_depth << "; max-depth = " << statistics.max_depth
+		<< "; consumer-stall = " << statistics.consumer_stall << " s; producer-stall = " 
+		<< statistics.producer_stall << " s\n";
+}
+/* bitmap of mutants in the set */
+static BitSeq selection_bitmap(const std::set<Mutant::ID> & mutants) {
+	BitSeq bitmap(mutants.empty() ? 0 : *(mutants.rbegin()) + 1);
+	auto beg = mutants.begin(), end = mutants.end();
+	while (beg != end) bitmap.set_bit(*(beg++), BIT_1);
+	return bitmap;
+}
+ScoreFilter::ScoreFilter(ScoreProducer & prod, const std::set<Mutant::ID> & temp)
+	: producer(prod), _template(temp), bitmap(selection_bitmap(temp)) {
+	pushed = producer.select(&bitmap);
 }
 ScoreVector * ScoreFilter::produce() {
+	if (pushed) return producer.produce();
+
 	ScoreVector * vec;
 	while ((vec = producer.produce()) != nullptr) {
 		// if (vec->get_degree() == 0)			// filter equivalent 
 			// continue;
-		if (_template.count(vec->get_mutant()) == 0)	// filter unselected ones
-			continue;
+		Mutant::ID mid = vec->get_mutant();
+		if (mid >= bitmap.bit_number() || bitmap.get_bit(mid) == BIT_0)
+			delete vec;		// filter unselected ones
 		else return vec;		// otherwise, return the vector
 	}
 	return nullptr;
 }
+ScoreBatch * ScoreFilter::produce_batch(size_t n) {
+	if (pushed) return producer.produce_batch(n);
+	else return ScoreProducer::produce_batch(n);
+}
 
 CoverageVector * CoverageProducer::produce() {
 	if (beg >= end) return nullptr;
@@ -19,24 +19,46 @@
 #include "cmutant.h"
 #include "ctrace.h"
 #include "ctest.h"
+#include "cthread.h"
+#include <deque>
 
 class ScoreVector;
+class ScoreBatch;
 class ScoreFunction;
 class ScoreSource;
 class CScore;
 class ScoreProducer;
 class ScoreConsumer;
 
+class ScoreTextScanner;
 class FileScoreProducer;
+class ParallelScoreProducer;
+class BinaryScoreProducer;
+class PrefetchScoreProducer;
 class ScoreFilter;
 class CoverageScoreProducer;
 
+/* degree of mutant that has no line in text score file */
+static const unsigned int BINARY_SCORE_ABSENT = 0xFFFFFFFF;
+/* default number of bytes in the chunk parsed by one task */
+static const size_t PARALLEL_SCORE_CHUNK = 1 << 20;
+/* default number of vectors in a batch */
+static const size_t SCORE_BATCH_SIZE = 1024;
+
 /* score vector */
 class ScoreVector {
 protected:
 	ScoreVector(const ScoreFunction & func,
 		Mutant::ID id, BitSeq::size_t tnum)
 		: function(func), mid(id), svec(tnum), degree(0) {}
+	/* create the vector whose bits are kept in external (all-zero) words */
+	ScoreVector(const ScoreFunction & func,
+		Mutant::ID id, BitSeq::size_t tnum, word * words)
+		: function(func), mid(id), svec(tnum, words), degree(0) {}
+	/* create the read-only view of external words */
+	ScoreVector(const ScoreFunction & func,
+		Mutant::ID id, BitSeq::size_t tnum, const word * words)
+		: function(func), mid(id), svec(tnum, words), degree(0) {}
 	~ScoreVector() {}
 
 	/* to set the bit referring to this mutant as 1 */
@@ -53,16 +75,90 @@ public:
 
 	/* create and kill-set */
 	friend class FileScoreProducer;
+	friend class BinaryScoreProducer;
+	/* create, kill-set and delete (not emitted) */
+	friend class ParallelScoreProducer;
+	/* delete (not emitted) */
+	friend class PrefetchScoreProducer;
+	/* delete (not selected) */
+	friend class ScoreFilter;
 	/* create */
 	friend class CoverageScoreProducer;
 	/* delete */
 	friend class ScoreConsumer;
+	/* delete (copied into batch) */
+	friend class ScoreProducer;
+	/* create, copy and delete in batch */
+	friend class ScoreBatch;
+	/* create as row view and set degree */
+	friend class MatrixScoreProducer;
+	/* create and set bits and degree */
+	friend class ProjectedScoreProducer;
 protected:
 	const ScoreFunction & function;
 	Mutant::ID mid;
 	BitSeq svec;
 	BitSeq::size_t degree;
 };
+/*
+*	block of score vectors of one function, whose bits are kept in one
+*	allocation of rows (one row of words for each vector), and the vectors
+*	themselves in another one.
+*/
+class ScoreBatch {
+protected:
+	/* create an empty batch of at most n vectors (rows are not allocated if vectors view external words) */
+	ScoreBatch(const ScoreFunction &, size_t, bool = true);
+	/* delete the vectors and their rows */
+	~ScoreBatch();
+
+	/* append an all-zero vector for the mutant (batch should not be full) */
+	ScoreVector & append(Mutant::ID);
+	/* append a copy of another vector (batch should not be full) */
+	ScoreVector & append(const ScoreVector &);
+	/* append a vector that views external words (batch should not be full) */
+	ScoreVector & append(Mutant::ID, const word *);
+
+public:
+	/* get the score function of vectors in batch */
+	const ScoreFunction & get_function() const { return function; }
+	/* number of vectors in batch */
+	size_t size() const { return number; }
+	/* maximal number of vectors in batch */
+	size_t capacity() const { return limit; }
+	/* whether no more vector can be appended */
+	bool full() const { return number >= limit; }
+	/* get the kth vector in batch */
+	const ScoreVector & get_vector(size_t k) const { return vectors[k]; }
+
+	/* create and append */
+	friend class ScoreProducer;
+	friend class FileScoreProducer;
+	friend class BinaryScoreProducer;
+	friend class MatrixScoreProducer;
+	friend class ProjectedScoreProducer;
+	/* delete */
+	friend class ScoreConsumer;
+
+private:
+	const ScoreFunction & function;
+	/* number of bits in each vector */
+	BitSeq::size_t bits;
+	/* number of words in each row */
+	size_t stride;
+	/* number of vectors appended */
+	size_t number;
+	/* maximal number of vectors */
+	size_t limit;
+	/* limit x stride words (null if vectors view external words) */
+	word * rows;
+	/* storage of limit vectors, where [0, number) are constructed */
+	ScoreVector * vectors;
+
+	/* batch cannot be copied */
+	ScoreBatch(const ScoreBatch &) = delete;
+	ScoreBatch & operator = (const ScoreBatch &) = delete;
+};
 /* template to create score vector from result.txt */
 class ScoreFunction {
 protected:
@@ -77,6 +173,8 @@ public:
 	/* get the mutants set of this function */
 	const MutantSet & get_mutants() const { return mutants; }
 
+	/* get the number of bits mapped to tests in score vector */
+	BitSeq::size_t number_of_bits() const { return bid_tid.size(); }
 	/* get the test id the kth bit in score vector refers to */
 	TestCase::ID get_test_id_at(BitSeq::size_t) const;
 	/* get the index of bit in score vector that refers to the specified test */
@@ -113,6 +211,17 @@ public:
 	const TestSpace & get_test_space() const { return tspace; }
 	/* get ../score/{codefile}.txt */
 	const File & get_result_file() const { return rfile; }
+	/* get the path of ../score/{codefile}.bin */
+	const std::string & get_binary_path() const { return bpath; }
+	/* whether ../score/{codefile}.bin is valid for the spaces and not older than the text file */
+	bool has_binary_file() const;
+	/* convert the text file into ../score/{codefile}.bin */
+	bool convert_to_binary() const;
+
+	/* create a producer for the function, reading binary file if available, or parsing text in parallel */
+	ScoreProducer * create_producer(const ScoreFunction &) const;
+	/* delete the producer created by this source */
+	void delete_producer(ScoreProducer *) const;
 
 	/* create a new (template) function in the score source */
 	ScoreFunction * create_function(const TestSet &, const MutantSet &);
@@ -129,6 +238,8 @@ private:
 	const MutantSpace & mspace;
 	const TestSpace & tspace;
 	const File & rfile;
+	/* path to the binary file */
+	std::string bpath;
 	/* set of score functions */
 	std::set<ScoreFunction *> function_pool;
 };
@@ -164,11 +275,36 @@ private:
 /* to produce score vectors (abstract) */
 class ScoreProducer {
 protected:
-	ScoreProducer() {}
-	virtual ~ScoreProducer() {}
+	ScoreProducer() : selection(nullptr) {}
+	virtual ~ScoreProducer() { if (selection != nullptr) delete selection; }
 
 public:
 	virtual ScoreVector * produce() { return nullptr; }
+	/* 
+	*	produce the next at most n vectors in one batch (null when no more vector).
+	*	By default the vectors from produce() are copied into the batch.
+	*/
+	virtual ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
+
+	/*
+	*	produce only the mutants whose bits are 1 in the bitmap (null for all mutants), 
+	*	which is copied by the producer; false if not supported.
+	*/
+	virtual bool select(const BitSeq *) { return false; }
+
+	/* create and delete */
+	friend class ScoreSource;
+protected:
+	/* copy of the bitmap of selected mutants (null for all) */
+	const BitSeq * selection;
+
+	/* replace the selection by a copy of bitmap (null for all) */
+	void set_selection(const BitSeq *);
+
+	/* whether the mutant is selected */
+	bool is_selected(Mutant::ID mid) const {
+		return selection == nullptr || (mid < selection->bit_number() && selection->get_bit(mid));
+	}
 };
 /* consumer for score vectors */
 class ScoreConsumer {
@@ -188,11 +324,57 @@ public:
 			else return false;
 		}
 	}
+	/* consume the produced batch with all vectors in it */
+	bool consume_batch(ScoreBatch * batch) {
+		if (batch == nullptr) return false;
+		else if (&(batch->get_function()) == function) {
+			delete batch; return true;
+		}
+		else return false;
+	}
 protected:
 	const ScoreFunction * function;
 };
 
-/* produce score vectors from file */
+/* 
+*	scanner of ../score/xxx.txt mapped in memory, where each line is parsed as:
+*	1) digits before '[' form the mutant id (line without '[' is skipped);
+*	2) characters until ':' are skipped;
+*	3) each 't' followed by digits (till space) gives a test that kills the mutant.
+*/
+class ScoreTextScanner {
+public:
+	/* map the text file for scanning */
+	ScoreTextScanner(const std::string &);
+	/* scan the lines in [beg, end) of text in memory */
+	ScoreTextScanner(const char *, const char *);
+	/* unmap the file (if mapped by this scanner) */
+	~ScoreTextScanner() { if (file != nullptr) delete file; }
+
+	/* move to the next line with score vector and get its mutant; false at the end of file */
+	bool next_mutant(Mutant::ID &);
+	/* get the next test in current line; false at the end of line */
+	bool next_test(TestCase::ID &);
+	/* skip the lines of mutants whose bits are 0 in the bitmap (null for none) */
+	void set_selection(const BitSeq * bitmap) { selection = bitmap; }
+	/* the beginning of the line after current one */
+	const char * get_cursor() const { return cursor; }
+
+private:
+	/* ../score/xxx.txt mapped in memory (null when scanning given text) */
+	MappedFile * file;
+	/* bitmap of mutants whose lines are scanned (null for all) */
+	const BitSeq * selection;
+	/* the end of text */
+	const char * fend;
+	/* the beginning of next line in file */
+	const char * cursor;
+	/* the next character in current line */
+	const char * k;
+	/* the end of current line */
+	const char * n;
+};
+/* produce score vectors from ../score/xxx.txt */
 class FileScoreProducer : public ScoreProducer {
 public:
 	/* create a producer for score function */
@@ -204,24 +386,192 @@ public:
 	const ScoreFunction & get_function() const { return function; }
 	/* produce the next vector from score function's source: ../score/xxx.txt */
 	ScoreVector * produce();
+	/* parse the next at most n lines into one batch */
+	ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
+	/* skip the lines of unselected mutants without parsing their tests */
+	bool select(const BitSeq *);
+
+protected:
+	const ScoreFunction & function;
+	ScoreTextScanner scanner;
+};
+/*
+*	produce score vectors from ../score/xxx.txt by parsing chunks of lines
+*	on a thread pool, while vectors are still produced in the file order.
+*/
+class ParallelScoreProducer : public ScoreProducer {
+public:
+	/* create a producer with specified threads (0 for cores) and bytes in each chunk */
+	ParallelScoreProducer(const ScoreFunction &, size_t = 0, size_t = PARALLEL_SCORE_CHUNK);
+	/* wait for the running tasks and delete vectors not produced */
+	~ParallelScoreProducer();
+
+	/* get score function */
+	const ScoreFunction & get_function() const { return function; }
+	/* produce the next vector in the file order */
+	ScoreVector * produce();
+	/* skip the lines of unselected mutants, where the chunks not produced yet are parsed again */
+	bool select(const BitSeq *);
+
+private:
+	/* lines parsed by one task */
+	struct Chunk {
+		const char * beg;
+		const char * end;
+		std::vector<ScoreVector *> vectors;
+		/* the end of line of each vector */
+		std::vector<const char *> ends;
+		std::future<void> done;
+	};
+
+	const ScoreFunction & function;
+	/* ../score/xxx.txt mapped in memory */
+	MappedFile file;
+	/* workers to parse chunks */
+	ThreadPool pool;
+	/* chunk k is [bounds[k], bounds[k + 1]), split at line ends */
+	std::vector<const char *> bounds;
+	/* chunks being parsed or produced, in the file order */
+	std::deque<Chunk *> window;
+	/* maximum chunks in window */
+	size_t window_size;
+	/* index of next chunk to submit */
+	size_t next_chunk;
+	/* index of next vector to produce in the front chunk */
+	size_t next_vector;
+
+	/* submit chunks till the window is full */
+	void fill_window();
+	/* wait for the chunks in window and delete the vectors not produced */
+	void drain_window();
+	/* parse the lines in chunk into vectors */
+	void parse(Chunk &);
+};
+/*
+*	produce score vectors from ../score/xxx.bin, which is (little-endian):
+*	1) header of 32 bytes: "MSGSCORE", version, mutants, tests, stride, 0, 0 (32-bit integers);
+*	2) mutants x stride words, where bit t of row m is 1 if test t kills mutant m;
+*	3) degree of each mutant (32-bit), or BINARY_SCORE_ABSENT if it is not in text file.
+*/
+class BinaryScoreProducer : public ScoreProducer {
+public:
+	/* create a producer for score function from its binary source */
+	BinaryScoreProducer(const ScoreFunction &);
+	/* deconstructor */
+	~BinaryScoreProducer() {}
+
+	/* get score function */
+	const ScoreFunction & get_function() const { return function; }
+	/* produce the vector of next mutant in the file (by increasing id) */
+	ScoreVector * produce();
+	/* produce the vector of specified mutant, without reading other rows (null if absent) */
+	ScoreVector * produce(Mutant::ID);
+	/* copy the next at most n rows into one batch */
+	ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
+	/* skip the rows of unselected mutants in produce() and produce_batch() */
+	bool select(const BitSeq *);
+
+	/* number of mutants in the file */
+	Mutant::ID number_of_mutants() const { return mutants; }
+	/* number of tests in the file */
+	TestCase::ID number_of_tests() const { return tests; }
+
+	/* convert text file to binary file of specified mutants and tests (replaced only when completed) */
+	static bool convert(const std::string &, const std::string &, Mutant::ID, TestCase::ID);
+	/* whether binary file is complete and of the specified mutants and tests */
+	static bool validate(const std::string &, Mutant::ID, TestCase::ID);
 
 protected:
 	const ScoreFunction & function;
-	LineReader reader;
+	/* ../score/xxx.bin mapped in memory */
+	MappedFile file;
+	Mutant::ID mutants;
+	TestCase::ID tests;
+	/* words in each row */
+	unsigned int stride;
+	/* rows of kill-bits */
+	const word * rows;
+	/* degree of each mutant */
+	const unsigned int * degrees;
+	/* next mutant to produce */
+	Mutant::ID cursor;
+	/* whether the function's bit k refers to test k */
+	bool identity;
+
+	/* set the bits of vector by the row of its mutant */
+	void load_row(ScoreVector &) const;
+};
+/*
+*	decorator that runs another producer on a background thread and 
+*	passes its vectors through a bounded single-producer/single-consumer queue.
+*	The inner producer should not be used by others till this one is deleted.
+*/
+class PrefetchScoreProducer : public ScoreProducer {
+public:
+	/* statistics of the queue */
+	struct Statistics {
+		/* number of vectors produced */
+		size_t vectors;
+		/* sum of queue depth seen by each produce() */
+		size_t depth_sum;
+		/* maximum queue depth seen by produce() */
+		size_t max_depth;
+		/* seconds that produce() waited for empty queue */
+		double consumer_stall;
+		/* seconds that the background thread waited for full queue */
+		double producer_stall;
+	};
+
+	/* start prefetching from the producer with a queue of specified capacity */
+	PrefetchScoreProducer(ScoreProducer &, size_t = 256);
+	/* stop the background thread and delete the vectors not produced */
+	~PrefetchScoreProducer();
+
+	/* produce the next vector in the order of inner producer */
+	ScoreVector * produce();
+
+	/* get the statistics of queue */
+	const Statistics & get_statistics() const { return statistics; }
+	/* print the statistics as one line */
+	void report(std::ostream &) const;
+
+private:
+	/* producer run in background */
+	ScoreProducer & producer;
+	/* vectors fetched but not produced */
+	SPSCQueue<ScoreVector *> queue;
+	/* whether inner producer returns null */
+	std::atomic<bool> finished;
+	/* whether background thread should stop */
+	std::atomic<bool> stopping;
+	/* statistics (producer_stall is written by background thread till it is joined) */
+	Statistics statistics;
+	/* background thread */
+	std::thread worker;
+
+	/* loop of background thread */
+	void fetch();
 };
 /* filter | select score vector for mutants */
 class ScoreFilter : public ScoreProducer {
 public:
-	ScoreFilter(ScoreProducer & prod, const std::set<Mutant::ID> & temp)
-		: producer(prod), _template(temp) {}
+	/* select the mutants in template, and push the selection down to producer if it supports */
+	ScoreFilter(ScoreProducer &, const std::set<Mutant::ID> &);
+	/* deconstructor (the producer keeps its copy of selection) */
 	~ScoreFilter() {}
 
 	/* produce the next vector from score function's source: ../score/xxx.txt */
 	ScoreVector * produce();
+	/* produce the next batch of selected vectors */
+	ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
 
 private:
 	ScoreProducer & producer;
 	const std::set<Mutant::ID> & _template;
+	/* bitmap of mutants in template */
+	BitSeq bitmap;
+	/* whether producer skips the unselected mutants itself */
+	bool pushed;
 };
 
 /* vector to represent the coverage for each mutant */
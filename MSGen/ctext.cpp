@@ -1,5 +1,16 @@
 #include "ctext.h"
 #include <iostream>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <sys/stat.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /** class LineReader: implement **/
 LineReader::LineReader(const std::string & filename) : in(filename, std::ios::in) {
@@ -25,6 +36,56 @@ void LineReader::roll() {
 	}
 }
 
+/** class MappedFile: implement **/
+MappedFile::MappedFile(const std::string & filename) : data(nullptr), length(0) {
+	bool failed = false;
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	LARGE_INTEGER fsize;
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fsize)) failed = true;
+	else if (fsize.QuadPart > 0) {
+		length = (size_t)fsize.QuadPart;
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL) failed = true;
+		else {
+			/* the view keeps the mapping alive after the handles are closed */
+			data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (data == nullptr) failed = true;
+			CloseHandle(mapping);
+		}
+	}
+	if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+	int fd = open(filename.c_str(), O_RDONLY); struct stat fstate;
+	if (fd < 0 || fstat(fd, &fstate) != 0) failed = true;
+	else if (fstate.st_size > 0) {
+		length = (size_t)fstate.st_size;
+		void * view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (view == MAP_FAILED) failed = true;
+		else {
+			data = (const char *)view;
+			madvise(view, length, MADV_SEQUENTIAL);
+		}
+	}
+	if (fd >= 0) close(fd);
+#endif
+	if (failed) {
+		std::cerr << "Invalid filename: \"" << filename << "\"" << std::endl;
+		exit(1);
+	}
+	if (data == nullptr) length = 0;
+}
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+#if defined(_WIN32)
+		UnmapViewOfFile(data);
+#else
+		munmap((void *)data, length);
+#endif
+	}
+}
+
 /** class TextBuild: implement **/
 TextBuild::TextBuild(LineReader &reader) : text(), lines() {
 	lines.push_back(text.length());
@@ -150,6 +211,16 @@ void File::clear() {
 bool is_space(char ch) {
 	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
 }
+long long last_modified(const std::string & path) {
+#if defined(_WIN32)
+	struct _stat64 state;
+	if (_stat64(path.c_str(), &state) != 0) return -1;
+#else
+	struct stat state;
+	if (stat(path.c_str(), &state) != 0) return -1;
+#endif
+	return (long long)state.st_mtime;
+}
 bool exist_file(const std::string & path) {
 	std::fstream file;
 	file.open(path, std::ios::in);
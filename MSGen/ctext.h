@@ -4,7 +4,8 @@
 * 	-Aim: to provide interfaces for access to file text
 * 	-Cls:
 * 		[1] class LineReader;
-* 		[2] class TextBuild;
+* 		[2] class MappedFile;
+* 		[3] class TextBuild;
 * 	-Dat: March 10th, 2017
 * 	-Art: Lin Huan
 * **/
@@ -14,6 +15,7 @@
 #include <fstream>
 
 class LineReader;
+class MappedFile;
 class TextBuild;
 class File;
 
@@ -22,6 +24,8 @@ class File;
 extern bool is_space(char);
 /* whether file exist */
 extern bool exist_file(const std::string &);
+/* last modified time of file (in seconds), -1 if file does not exist */
+extern long long last_modified(const std::string &);
 /* whether first string begins with another */
 extern bool startswith(const std::string &, const std::string &);
 /* whether first string ends with another */
@@ -63,6 +67,34 @@ private:
 	void roll();
 };
 /*
+* Read-only view of the whole file mapped in memory
+* (CreateFileMapping on Windows, mmap on POSIX)
+* */
+class MappedFile {
+public:
+	/* map the file into memory */
+	MappedFile(const std::string &);
+	/* unmap the file */
+	~MappedFile();
+
+	/* first character in file (null for empty file) */
+	const char * begin() const { return data; }
+	/* the end of characters in file */
+	const char * end() const { return data + length; }
+	/* number of characters in file */
+	size_t size() const { return length; }
+
+private:
+	/* mapped view of file */
+	const char * data;
+	/* length of the file */
+	size_t length;
+
+	/* file cannot be copied */
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator = (const MappedFile &) = delete;
+};
+/*
 * Build for text to retrieve character by their lines
 * */
 class TextBuild {
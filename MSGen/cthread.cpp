@@ -0,0 +1,146 @@
+#include "cthread.h"
+
+ThreadPool::ThreadPool(size_t threads) : workers(), tasks(), lock(), ready(), stopping(false) {
+	if (threads == 0) threads = default_threads();
+	for (size_t i = 0; i < threads; i++)
+		workers.push_back(std::thread(&ThreadPool::run, this));
+}
+ThreadPool::~ThreadPool() {
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		stopping = true;
+	}
+	ready.notify_all();
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+}
+size_t ThreadPool::default_threads() {
+	size_t n = std::thread::hardware_concurrency();
+	return (n == 0) ? 1 : n;
+}
+void ThreadPool::run() {
+	while (true) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) return;	/* stopping */
+			task = std::move(tasks.front()); tasks.pop();
+		}
+		task();
+	}
+}
+std::future<void> ThreadPool::submit(std::function<void()> body) {
+	std::packaged_task<void()> task(body);
+	std::future<void> result = task.get_future();
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		tasks.push(std::move(task));
+	}
+	ready.notify_one();
+	return result;
+}
+void ThreadPool::parallel_for(size_t n, const std::function<void(size_t)> & body) {
+	if (n == 0) return;
+
+	/* a few blocks for each worker to balance the load */
+	size_t blocks = size() * 4;
+	if (blocks > n) blocks = n;
+	size_t step = (n + blocks - 1) / blocks;
+
+	std::vector<std::future<void>> results;
+	for (size_t beg = 0; beg < n; beg += step) {
+		size_t end = (beg + step < n) ? beg + step : n;
+		results.push_back(submit([&body, beg, end] {
+			for (size_t i = beg; i < end; i++) body(i);
+		}));
+	}
+	for (size_t i = 0; i < results.size(); i++)
+		results[i].get();
+}
+
+thread_local ForkJoinPool * ForkJoinPool::current = nullptr;
+thread_local size_t ForkJoinPool::current_index = 0;
+ForkJoinPool::ForkJoinPool(size_t threads) : workers(), deques(), queued(0), lock(), ready(), stopping(false) {
+	if (threads == 0) threads = ThreadPool::default_threads();
+	for (size_t i = 0; i <= threads; i++)
+		deques.push_back(new Deque());
+	for (size_t i = 0; i < threads; i++)
+		workers.push_back(std::thread(&ForkJoinPool::run, this, i));
+}
+ForkJoinPool::~ForkJoinPool() {
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		stopping = true;
+	}
+	ready.notify_all();
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+	for (size_t i = 0; i < deques.size(); i++)
+		delete deques[i];
+}
+void ForkJoinPool::run(size_t index) {
+	current = this; current_index = index;
+	while (true) {
+		Task task;
+		if (take(index, task)) { execute(task); continue; }
+
+		std::unique_lock<std::mutex> guard(lock);
+		ready.wait(guard, [this] { return stopping || queued.load() > 0; });
+		if (stopping && queued.load() == 0) return;
+	}
+}
+void ForkJoinPool::push(size_t index, const Task & task) {
+	{
+		std::unique_lock<std::mutex> guard(deques[index]->lock);
+		deques[index]->tasks.push_back(task);
+	}
+	queued++;
+	{
+		/* the idle workers are either waiting or will see the task */
+		std::unique_lock<std::mutex> guard(lock);
+	}
+	ready.notify_one();
+}
+bool ForkJoinPool::take(size_t index, Task & task) {
+	{
+		Deque & own = *(deques[index]);
+		std::unique_lock<std::mutex> guard(own.lock);
+		if (!own.tasks.empty()) {
+			task = own.tasks.back(); own.tasks.pop_back();
+			queued--; return true;
+		}
+	}
+	for (size_t k = 1; k < deques.size(); k++) {
+		Deque & other = *(deques[(index + k) % deques.size()]);
+		std::unique_lock<std::mutex> guard(other.lock);
+		if (!other.tasks.empty()) {
+			task = other.tasks.front(); other.tasks.pop_front();
+			queued--; return true;
+		}
+	}
+	return false;
+}
+void ForkJoinPool::execute(const Task & task) {
+	(*(task.body))();
+	task.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+void ForkJoinPool::invoke(std::vector<std::function<void()>> & tasks) {
+	if (tasks.empty()) return;
+	size_t index = (current == this) ? current_index : workers.size();
+
+	/* fork the others (the first one to be popped at back) and run the first here */
+	std::atomic<size_t> pending(tasks.size() - 1);
+	for (size_t k = tasks.size() - 1; k > 0; k--) {
+		Task task; task.body = &(tasks[k]); task.pending = &pending;
+		push(index, task);
+	}
+	tasks[0]();
+
+	/* help to run the tasks till all forked ones are done */
+	while (pending.load(std::memory_order_acquire) > 0) {
+		Task task;
+		if (take(index, task)) execute(task);
+		else std::this_thread::yield();
+	}
+}
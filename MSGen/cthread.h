@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+-File : cthread.h
+-Date : Oct 16th, 2026
+-Purp : to run tasks on a fixed set of worker threads
+-Clas :
+	[1] ThreadPool
+	[2] SPSCQueue<T>
+	[3] ForkJoinPool
+*/
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <deque>
+
+class ThreadPool;
+template<class T> class SPSCQueue;
+class ForkJoinPool;
+
+/* fixed set of workers that run the submitted tasks in FIFO order */
+class ThreadPool {
+public:
+	/* create a pool of specified workers (0 for the number of cores) */
+	ThreadPool(size_t = 0);
+	/* run the remaining tasks and join all workers */
+	~ThreadPool();
+
+	/* number of workers */
+	size_t size() const { return workers.size(); }
+	/* submit a task and get the future for its completion */
+	std::future<void> submit(std::function<void()>);
+	/* 
+	*	run body(i) for i in [0, n) on workers and wait for all of them;
+	*	should not be called within the tasks of the same pool.
+	*/
+	void parallel_for(size_t, const std::function<void(size_t)> &);
+
+	/* number of cores on this machine (at least 1) */
+	static size_t default_threads();
+
+private:
+	/* worker threads */
+	std::vector<std::thread> workers;
+	/* tasks waiting for workers */
+	std::queue<std::packaged_task<void()>> tasks;
+	/* lock for tasks and stopping */
+	std::mutex lock;
+	/* notified when task is submitted or pool is stopping */
+	std::condition_variable ready;
+	/* whether the pool is being deleted */
+	bool stopping;
+
+	/* loop of each worker */
+	void run();
+
+	/* pool cannot be copied */
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator = (const ThreadPool &) = delete;
+};
+/*
+*	Bounded lock-free queue between exactly one pushing thread and one popping thread.
+*	The ring has a power-of-2 number of slots, and head | tail are only written by
+*	the popping | pushing thread respectively.
+*/
+template<class T> class SPSCQueue {
+public:
+	/* create a queue that holds at least the specified number of items */
+	SPSCQueue(size_t capacity) : head(0), tail(0) {
+		size_t n = 2;
+		while (n < capacity) n <<= 1;
+		slots.resize(n); mask = n - 1;
+	}
+	/* deconstructor */
+	~SPSCQueue() {}
+
+	/* number of items that can be held */
+	size_t capacity() const { return slots.size(); }
+	/* number of items in queue (approximate when the other thread is running) */
+	size_t size() const { 
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); 
+	}
+
+	/* push the item at tail (pushing thread only), false if queue is full */
+	bool push(const T & item) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) > mask) return false;
+		slots[t & mask] = item;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+	/* pop the item at head (popping thread only), false if queue is empty */
+	bool pop(T & item) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) return false;
+		item = slots[h & mask];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	/* ring of items */
+	std::vector<T> slots;
+	/* slots.size() - 1 */
+	size_t mask;
+	/* index of next item to pop (in its own cache line) */
+	alignas(64) std::atomic<size_t> head;
+	/* index of next item to push (in its own cache line) */
+	alignas(64) std::atomic<size_t> tail;
+};
+/*
+*	Workers for nested fork-join tasks by work stealing: each worker pushes | pops the
+*	tasks it forks at the back of its own deque, and idle ones steal from the front of
+*	the others. A thread waiting for its forked tasks runs the tasks it can find (its
+*	own first) rather than blocking, so tasks may fork and wait again.
+*/
+class ForkJoinPool {
+public:
+	/* create a pool of specified workers (0 for the number of cores) */
+	ForkJoinPool(size_t = 0);
+	/* join all workers (no task should be running) */
+	~ForkJoinPool();
+
+	/* number of workers */
+	size_t size() const { return workers.size(); }
+	/* run the tasks in parallel and return when all are done (also in a task of this pool) */
+	void invoke(std::vector<std::function<void()>> &);
+
+private:
+	/* forked task and the counter of its join */
+	struct Task {
+		std::function<void()> * body;
+		std::atomic<size_t> * pending;
+	};
+	/* tasks of one worker (or the threads out of pool at last) */
+	struct Deque {
+		std::deque<Task> tasks;
+		std::mutex lock;
+	};
+
+	/* worker threads */
+	std::vector<std::thread> workers;
+	/* deques of the workers, and the one shared by the threads out of pool */
+	std::vector<Deque *> deques;
+	/* number of tasks in all deques */
+	std::atomic<size_t> queued;
+	/* lock for idle workers and stopping */
+	std::mutex lock;
+	/* notified when task is pushed or pool is stopping */
+	std::condition_variable ready;
+	/* whether the pool is being deleted */
+	bool stopping;
+
+	/* pool of current thread (null if not a worker) */
+	static thread_local ForkJoinPool * current;
+	/* index of current worker in its pool */
+	static thread_local size_t current_index;
+
+	/* loop of the kth worker */
+	void run(size_t);
+	/* push the task at the back of the kth deque */
+	void push(size_t, const Task &);
+	/* pop the task from the back of the kth deque, or steal one from the front of the others */
+	bool take(size_t, Task &);
+	/* run the task and count down its join */
+	void execute(const Task &);
+
+	/* pool cannot be copied */
+	ForkJoinPool(const ForkJoinPool &) = delete;
+	ForkJoinPool & operator = (const ForkJoinPool &) = delete;
+};
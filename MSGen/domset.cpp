@@ -1,4 +1,5 @@
 #include "domset.h"
+#include "bitkern.h"
 #include <cstdlib>
 #include <time.h>
 
@@ -33,29 +34,141 @@ static void random_sort(std::vector<MSG_Node *> & list) {
 /// score matrix
 void ScoreMatrix::add_score_vectors(
 	ScoreProducer & producer, ScoreConsumer & consumer) {
-	ScoreVector * svec; 
+	ScoreBatch * batch; 
 	equivalents = 0;
-	while ((svec = producer.produce()) != nullptr) {
-		/* get the next score vector */
-		Mutant::ID mid = svec->get_mutant();
-		const BitSeq & bits = svec->get_vector();
-
-		/* update the matrix */
-		BitSeq::size_t bias = 
-			mid * tspace.number_of_tests();
-		BitSeq::size_t i, n = bits.bit_number();
-		for (i = 0; i < n; i++) {
-			bit bi = bits.get_bit(i);
-			matrix->set_bit(bias + i, bi);
+	while ((batch = producer.produce_batch()) != nullptr) {
+		for (size_t k = 0; k < batch->size(); k++) {
+			/* get the next score vector */
+			const ScoreVector & svec = batch->get_vector(k);
+			Mutant::ID mid = svec.get_mutant();
+			const BitSeq & bits = svec.get_vector();
+
+			/* update the matrix */
+			matrix.set_row(mid, bits);
+			loaded.set_bit(mid, BIT_1);
+			degrees[mid] = svec.get_degree();
+
+			if (svec.get_degree() == 0)
+				equivalents++;
 		}
 
-		if (svec->get_degree() == 0)
-			equivalents++;
+		/* delete score vectors */
+		consumer.consume_batch(batch); 
+	}
+
+	/* build the test-major columns */
+	matrix.transpose();
+}
+MatrixScoreProducer::MatrixScoreProducer(const ScoreMatrix & m, const ScoreFunction & func)
+	: matrix(m), function(func), identity(false), masks(), cursor(0) {
+	size_t columns = m.get_matrix().column_number();
+	if (func.get_tests().size() > columns) {
+		CError error(CErrorType::InvalidArguments, "MatrixScoreProducer::MatrixScoreProducer", 
+			"Function has more tests than matrix: " + std::to_string(func.get_tests().size()));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+
+	/* rows are viewed directly when bit k refers to test k (and no column is left out) */
+	identity = (func.get_tests().size() == columns && func.number_of_bits() == columns);
+	for (TestCase::ID k = 0; identity && k < columns; k++)
+		identity = (func.get_test_id_at(k) == k);
+	if (!identity) ProjectedScoreProducer::test_masks(m, func, masks);
+}
+bool MatrixScoreProducer::next_mutant(Mutant::ID & mid) {
+	Mutant::ID n = matrix.get_matrix().row_number();
+	while (cursor < n) {
+		mid = cursor++;
+		if (matrix.has_score_vector(mid) && is_selected(mid)) return true;
+	}
+	return false;
+}
+ScoreVector * MatrixScoreProducer::produce() {
+	Mutant::ID mid;
+	if (!next_mutant(mid)) return nullptr;
+
+	ScoreVector * vec;
+	if (identity) {
+		vec = new ScoreVector(function, mid, function.get_tests().size(), matrix.get_kill_tests(mid));
+		vec->degree = matrix.get_degree(mid);
+	}
+	else {
+		vec = new ScoreVector(function, mid, function.get_tests().size());
+		ProjectedScoreProducer::project(matrix, masks, *vec);
+	}
+	return vec;
+}
+ScoreBatch * MatrixScoreProducer::produce_batch(size_t n) {
+	Mutant::ID mid; 
+	if (!next_mutant(mid)) return nullptr;
+
+	ScoreBatch * batch = new ScoreBatch(function, n, !identity);
+	while (true) {
+		if (identity) {
+			ScoreVector & vec = batch->append(mid, matrix.get_kill_tests(mid));
+			vec.degree = matrix.get_degree(mid);
+		}
+		else ProjectedScoreProducer::project(matrix, masks, batch->append(mid));
+		if (batch->full() || !next_mutant(mid)) break;
+	}
+	return batch;
+}
+bool MatrixScoreProducer::select(const BitSeq * bitmap) { set_selection(bitmap); return true; }
+ProjectedScoreProducer::ProjectedScoreProducer(const ScoreMatrix & m, const ScoreFunction & func)
+	: matrix(m), function(func), masks(), cursor(0) {
+	test_masks(m, func, masks);
+}
+bool ProjectedScoreProducer::next_mutant(Mutant::ID & mid) {
+	Mutant::ID n = matrix.get_matrix().row_number();
+	while (cursor < n) {
+		mid = cursor++;
+		if (matrix.has_score_vector(mid) && is_selected(mid)) return true;
+	}
+	return false;
+}
+void ProjectedScoreProducer::test_masks(const ScoreMatrix & m, const ScoreFunction & func, std::vector<word> & masks) {
+	masks.assign(m.get_matrix().row_words(), 0);
+
+	/* tests over the columns of matrix are ignored, as well as the padding bits */
+	const BitSeq & tvec = func.get_tests().get_set_vector();
+	size_t columns = m.get_matrix().column_number();
+	if (tvec.bit_number() < columns) columns = tvec.bit_number();
+
+	const word * words = tvec.get_words();
+	for (size_t i = 0; i < columns / WORD_BITS; i++) masks[i] = words[i];
+	if (columns % WORD_BITS != 0) {
+		size_t i = columns / WORD_BITS;
+		masks[i] = words[i] & ((((word)1) << (columns % WORD_BITS)) - 1);
+	}
+}
+void ProjectedScoreProducer::project(const ScoreMatrix & matrix, const std::vector<word> & masks, ScoreVector & vec) {
+	const BitKernel & kernel = BitKernel::get();
+	word * words = (vec.svec).get_words();
+	BitSeq::size_t n = (vec.svec).word_number();
+
+	/* the function's tests are fewer than its bits if it contains tests over matrix */
+	size_t bits = kernel.gather(words, matrix.get_kill_tests(vec.mid), masks.data(), masks.size());
+	for (size_t i = (bits + WORD_BITS - 1) / WORD_BITS; i < n; i++) words[i] = 0;
+	vec.degree = kernel.degree(words, n);
+}
+ScoreVector * ProjectedScoreProducer::produce() {
+	Mutant::ID mid;
+	if (!next_mutant(mid)) return nullptr;
 
-		/* delete score vector */
-		consumer.consume(svec); 
+	ScoreVector * vec = new ScoreVector(function, mid, function.get_tests().size());
+	project(matrix, masks, *vec); return vec;
+}
+ScoreBatch * ProjectedScoreProducer::produce_batch(size_t n) {
+	Mutant::ID mid; 
+	if (!next_mutant(mid)) return nullptr;
+
+	ScoreBatch * batch = new ScoreBatch(function, n);
+	while (true) {
+		project(matrix, masks, batch->append(mid));
+		if (batch->full() || !next_mutant(mid)) break;
 	}
+	return batch;
 }
+bool ProjectedScoreProducer::select(const BitSeq * bitmap) { set_selection(bitmap); return true; }
 
 /// greedy algorithm
 void DomSetBuilder_Greedy::derive_score_set(Mutant::ID mid, std::set<TestCase::ID> & scoreset) {
@@ -69,17 +182,6 @@ void DomSetBuilder_Greedy::derive_score_set(Mutant::ID mid, std::set<TestCase::I
 		counter->testing(mid, tid);
 	}
 }
-bool DomSetBuilder_Greedy::is_killed_by_all(Mutant::ID mj, const std::set<TestCase::ID> & scoreset) {
-	auto beg = scoreset.begin();
-	auto end = scoreset.end();
-	while (beg != end) {
-		TestCase::ID tid = *(beg++);
-		counter->testing(mj, tid);
-		if (!(matrix->get_result(mj, tid)))
-			return false;
-	}
-	return true;
-}
 void DomSetBuilder_Greedy::erase_subsummeds(Mutant::ID mi, std::set<Mutant::ID> & M) {
 	M.erase(mi);		// push
 
@@ -91,21 +193,32 @@ void DomSetBuilder_Greedy::erase_subsummeds(Mutant::ID mi, std::set<Mutant::ID>
 	counter->equivalent(mi);
 	if (scoreset.empty()) return;
 
-	/* compute those subsumed by mi */
-	std::set<Mutant::ID> erases;
+	/* candidates in M to be subsumed by mi */
+	BitSeq killeds(matrix->get_mutant_space().number_of_mutants());
 	auto beg = M.begin(), end = M.end();
 	while (beg != end) {
 		Mutant::ID mj = *(beg++);
 		counter->compare(mi, mj);
-		if (is_killed_by_all(mj, scoreset))
-			erases.insert(mj);
+		killeds.set_bit(mj, BIT_1);
 	}
 
-	/* update the set M */
-	beg = erases.begin();
-	end = erases.end();
-	while (beg != end)
-		M.erase(*(beg++));
+	/* intersect with the mutants killed by each test in score set */
+	word * kwords = killeds.get_words();
+	BitSeq::size_t kn = killeds.word_number();
+	auto tbeg = scoreset.begin(), tend = scoreset.end();
+	while (tbeg != tend && !killeds.all_zeros()) {
+		TestCase::ID tid = *(tbeg++);
+		BitKernel::get().conjunct(kwords, matrix->get_killed_mutants(tid), kn);
+	}
+
+	/* update the set M by those subsumed by mi */
+	for (BitSeq::size_t k = 0; k < kn; k++) {
+		word w = kwords[k];
+		while (w != 0) {
+			M.erase((Mutant::ID)(k * WORD_BITS + word_ctz(w)));
+			w &= w - 1;
+		}
+	}
 
 	M.insert(mi);		// pope
 }
@@ -375,8 +488,8 @@ MSG_Node * DomSetBuilder_Blocks::get_min_mutants(const std::set<MSG_Node *> & bl
 	MSG_Node * min = nullptr;
 	while(beg != end) {
 		MSG_Node * node = *(beg++);
-		if (node->get_mutants().number_of_mutants() < number) {
-			number = node->get_mutants().number_of_mutants();
+		if (node->size() < number) {
+			number = node->size();
 			min = node;
 		}
 	}
@@ -7,14 +7,19 @@
 	-date : Nov 2nd, 2017
 	-clas :
 		class ScoreMatrix
+		class MatrixScoreProducer
+		class ProjectedScoreProducer
 		class MutSet
 		class DomSetBuilder
 */
 
 #include "sgraph.h"
+#include "bitmatrix.h"
 
 // class declarations
 class ScoreMatrix;
+class MatrixScoreProducer;
+class ProjectedScoreProducer;
 class MutSet;
 class DomSetBuilder;
 
@@ -23,40 +28,132 @@ class DomSetBuilder_Blocks;
 
 class DomSetAlgorithm_Counter;
 
-/* score matrix */
+/* score matrix, kept both as mutant-major rows and test-major columns */
 class ScoreMatrix {
 public:
 	/* create a matrix based on the number of mutants and tests as inputs */
-	ScoreMatrix(MutantSpace & ms, TestSpace & ts) : mspace(ms), tspace(ts) {
-		matrix = new BitSeq(ms.number_of_mutants() * ts.number_of_tests());
-		matrix->clear_bytes(); 
-	}
+	ScoreMatrix(MutantSpace & ms, TestSpace & ts) : mspace(ms), tspace(ts), 
+		matrix(ms.number_of_mutants(), ts.number_of_tests()), equivalents(0),
+		loaded(ms.number_of_mutants()), degrees(ms.number_of_mutants(), 0) {}
 	/* deconstructor */
-	~ScoreMatrix() { delete matrix; }
-	/* add score vector into the matrix on its specified index */
+	~ScoreMatrix() {}
+	/* add score vector into the matrix on its specified index, then build the columns */
 	void add_score_vectors(ScoreProducer &, ScoreConsumer &);
 
 	/* get the mutant space */
 	inline MutantSpace & get_mutant_space() const { return mspace; }
 	/* get the test space */
 	inline TestSpace & get_test_space() const { return tspace; }
-	/* get the index of result in matrix specified by mutant and test */
-	inline BitSeq::size_t get_index_of(Mutant::ID mid, TestCase::ID tid) const {
-		return mid * tspace.number_of_tests() + tid;
-	}
 	/* get number of equivalents */
 	inline size_t get_equivalents() const { return equivalents; }
+	/* whether the score vector of mutant has been added */
+	inline bool has_score_vector(Mutant::ID mid) const { 
+		return mid < loaded.bit_number() && loaded.get_bit(mid) == BIT_1; 
+	}
+	/* get the number of tests that kill the mutant */
+	inline BitSeq::size_t get_degree(Mutant::ID mid) const { return degrees[mid]; }
 	/* whether mutant is killed by the test */
 	inline bool get_result(Mutant::ID mid, TestCase::ID tid) const {
-		BitSeq::size_t bias = mid * tspace.number_of_tests();
-		return matrix->get_bit(bias + tid) == BIT_1;
+		return matrix.get_bit(mid, tid) == BIT_1;
 	}
 
+	/* get the words of tests that kill the mutant (matrix.row_words()) */
+	inline const word * get_kill_tests(Mutant::ID mid) const { return matrix.get_row(mid); }
+	/* get the words of mutants killed by the test (matrix.column_words()) */
+	inline const word * get_killed_mutants(TestCase::ID tid) const { return matrix.get_column(tid); }
+	/* get the mutants killed by the test in increasing order */
+	inline const std::vector<unsigned int> & get_killed_list(TestCase::ID tid) const { return matrix.get_posting(tid); }
+	/* get the bit matrix of results */
+	inline const BitMatrix & get_matrix() const { return matrix; }
+
 private:
 	MutantSpace & mspace;
 	TestSpace & tspace;
-	BitSeq * matrix;
+	BitMatrix matrix;
 	size_t equivalents;
+	/* mutants whose score vectors are added */
+	BitSeq loaded;
+	/* degree of each mutant */
+	std::vector<BitSeq::size_t> degrees;
+};
+/*
+*	produce the score vectors added in matrix (by increasing mutant id) as views of
+*	its rows, without parsing or copying bits, when the function maps bit k to the
+*	kth column of matrix; otherwise the columns of its tests are packed into rows of
+*	their own as ProjectedScoreProducer does. The matrix should not be updated while
+*	the vectors are alive.
+*/
+class MatrixScoreProducer : public ScoreProducer {
+public:
+	/* create a producer over the rows of matrix */
+	MatrixScoreProducer(const ScoreMatrix &, const ScoreFunction &);
+	/* deconstructor */
+	~MatrixScoreProducer() {}
+
+	/* get score function */
+	const ScoreFunction & get_function() const { return function; }
+	/* produce the view of next row in matrix */
+	ScoreVector * produce();
+	/* produce the views of next at most n rows in one batch (without row storage) */
+	ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
+	/* skip the rows of unselected mutants */
+	bool select(const BitSeq *);
+	/* replay the rows from the first mutant */
+	void reset() { cursor = 0; }
+
+private:
+	const ScoreMatrix & matrix;
+	const ScoreFunction & function;
+	/* whether bit k of function refers to the kth column of matrix (rows can be viewed) */
+	bool identity;
+	/* words of the test set to pack the rows (empty when they are viewed) */
+	std::vector<word> masks;
+	/* next mutant to produce */
+	Mutant::ID cursor;
+
+	/* find the next mutant to produce, false at the end of matrix */
+	bool next_mutant(Mutant::ID &);
+};
+/*
+*	produce the score vectors added in matrix (by increasing mutant id) over the tests
+*	of function, where bit k refers to the kth test in its set. The columns of those
+*	tests are packed out of each row by BitKernel::gather (PEXT when available).
+*/
+class ProjectedScoreProducer : public ScoreProducer {
+public:
+	/* create a producer that projects the rows of matrix on tests of function */
+	ProjectedScoreProducer(const ScoreMatrix &, const ScoreFunction &);
+	/* deconstructor */
+	~ProjectedScoreProducer() {}
+
+	/* get score function */
+	const ScoreFunction & get_function() const { return function; }
+	/* produce the projection of next row in matrix */
+	ScoreVector * produce();
+	/* produce the projections of next at most n rows in one batch */
+	ScoreBatch * produce_batch(size_t = SCORE_BATCH_SIZE);
+	/* skip the rows of unselected mutants */
+	bool select(const BitSeq *);
+	/* replay the rows from the first mutant */
+	void reset() { cursor = 0; }
+
+private:
+	const ScoreMatrix & matrix;
+	const ScoreFunction & function;
+	/* words of the test set (matrix.row_words()) */
+	std::vector<word> masks;
+	/* next mutant to produce */
+	Mutant::ID cursor;
+
+	/* find the next mutant to produce, false at the end of matrix */
+	bool next_mutant(Mutant::ID &);
+
+	/* words of the function's test set over the columns of matrix */
+	static void test_masks(const ScoreMatrix &, const ScoreFunction &, std::vector<word> &);
+	/* pack the masked columns in the row of vector's mutant into its words */
+	static void project(const ScoreMatrix &, const std::vector<word> &, ScoreVector &);
+	/* test_masks and project */
+	friend class MatrixScoreProducer;
 };
 /* set for mutant records */
 class MutSet {
@@ -235,8 +332,6 @@ protected:
 
 	/* get the score set for each mutant */
 	void derive_score_set(Mutant::ID, std::set<TestCase::ID> &);
-	/* whether the mutant is killed by all the tests in set */
-	bool is_killed_by_all(Mutant::ID, const std::set<TestCase::ID> &);
 	/* eliminate those subsummed by the mi from set */
 	void erase_subsummeds(Mutant::ID, std::set<Mutant::ID> &);
 	/* get the next unvisited mutant from M, if all are visited, return false */
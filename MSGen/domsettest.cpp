@@ -263,7 +263,7 @@ static void print_graph(const MS_Graph & graph, std::ostream & out) {
 		MSG_Node & node = graph.get_node(id);
 		if (node.get_score_degree() > 0) {
 			out << id << "\t";
-			out << node.get_mutants().number_of_mutants() << "\t";
+			out << node.size() << "\t";
 			out << node.get_score_degree() << "\t";
 
 			const MSG_Port & port = node.get_ou_port();
@@ -0,0 +1,192 @@
+#include "fgraph.h"
+#include <algorithm>
+
+/* FrozenMSG */
+bool FrozenMSG::freeze(const MS_Graph & graph) {
+	this->clear(); size_t n = graph.size();
+
+	/* number the nodes and copy their vectors */
+	std::vector<size_t> list(n);
+	std::vector<const BitSeq *> vecs(n);
+	for (size_t i = 0; i < n; i++) {
+		MSG_Node & node = graph.get_node(i);
+		list[i] = node.get_score_degree();
+		vecs[i] = &(node.get_score_vector());
+	}
+	this->order_nodes(list);
+	this->set_vectors(vecs);
+
+	/* edges in frozen ids */
+	std::vector<std::pair<ID, ID>> edges;
+	for (size_t i = 0; i < n; i++) {
+		const MSG_Port & port = graph.get_node(i).get_ou_port();
+		for (size_t k = 0; k < port.degree(); k++) {
+			MSG_Node & next = port.get_edge(k).get_target();
+			edges.push_back(std::pair<ID, ID>(frozen_ids[i], frozen_ids[next.get_node_id()]));
+		}
+	}
+	this->set_edges(edges);
+
+	/* mutants in increasing order */
+	std::vector<std::pair<Mutant::ID, ID>> pairs;
+	const std::map<Mutant::ID, MSG_Node *> & index = graph.get_index();
+	auto beg = index.begin(), end = index.end();
+	while (beg != end) {
+		pairs.push_back(std::pair<Mutant::ID, ID>(beg->first, frozen_ids[beg->second->get_node_id()]));
+		beg++;
+	}
+	this->set_mutants(pairs);
+
+	return true;
+}
+bool FrozenMSG::freeze(const MSGraph & graph) {
+	this->clear(); size_t n = graph.size();
+
+	/* number the clusters and copy their vectors */
+	std::vector<size_t> list(n);
+	std::vector<const BitSeq *> vecs(n);
+	for (size_t i = 0; i < n; i++) {
+		MuCluster & cluster = graph.get_cluster(i);
+		list[i] = cluster.get_score_degree();
+		vecs[i] = &(cluster.get_score_vector());
+	}
+	this->order_nodes(list);
+	this->set_vectors(vecs);
+
+	/* edges in frozen ids */
+	std::vector<std::pair<ID, ID>> edges;
+	for (size_t i = 0; i < n; i++) {
+		const MuSubsumePort::EdgeList & port = graph.get_cluster(i).get_ou_port().get_edges();
+		auto beg = port.begin(), end = port.end();
+		while (beg != end) {
+			MuCluster & next = (beg++)->get_target();
+			edges.push_back(std::pair<ID, ID>(frozen_ids[i], frozen_ids[next.get_id()]));
+		}
+	}
+	this->set_edges(edges);
+
+	/* mutants in increasing order */
+	std::vector<std::pair<Mutant::ID, ID>> pairs;
+	const std::map<Mutant::ID, MuCluster *> & index = graph.get_index();
+	auto beg = index.begin(), end = index.end();
+	while (beg != end) {
+		pairs.push_back(std::pair<Mutant::ID, ID>(beg->first, frozen_ids[beg->second->get_id()]));
+		beg++;
+	}
+	this->set_mutants(pairs);
+
+	return true;
+}
+void FrozenMSG::clear() {
+	vectors.clear(); words.clear(); degrees.clear(); stride = 0;
+	origins.clear(); frozen_ids.clear();
+	ou_offsets.clear(); ou_targets.clear();
+	in_offsets.clear(); in_sources.clear();
+	mut_offsets.clear(); mutants.clear(); mut_nodes.clear();
+}
+FrozenNode FrozenMSG::get_node(ID id) const {
+	if (id >= size()) {
+		CError error(CErrorType::OutOfIndex, "FrozenMSG::get_node", 
+			"Invalid node-id (" + std::to_string(id) + ")");
+		CErrorConsumer::consume(error); exit(CErrorType::OutOfIndex);
+	}
+	else return FrozenNode(*this, id);
+}
+FrozenNode FrozenMSG::get_node_of_origin(long origin) const {
+	if (origin < 0 || origin >= frozen_ids.size()) {
+		CError error(CErrorType::OutOfIndex, "FrozenMSG::get_node_of_origin", 
+			"Invalid origin-id (" + std::to_string(origin) + ")");
+		CErrorConsumer::consume(error); exit(CErrorType::OutOfIndex);
+	}
+	else return FrozenNode(*this, frozen_ids[origin]);
+}
+FrozenNode FrozenMSG::get_node_of(Mutant::ID mid) const {
+	if (!has_node_of(mid)) {
+		CError error(CErrorType::InvalidArguments, "FrozenMSG::get_node_of(mid)",
+			"Undefined mid: " + std::to_string(mid));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	else return FrozenNode(*this, mut_nodes[mid]);
+}
+void FrozenMSG::order_nodes(const std::vector<size_t> & list) {
+	size_t n = list.size();
+	origins.resize(n);
+	for (size_t k = 0; k < n; k++) origins[k] = k;
+	std::stable_sort(origins.begin(), origins.end(), [&list](long x, long y) {
+		return list[x] < list[y];
+	});
+
+	frozen_ids.resize(n); degrees.resize(n);
+	for (size_t k = 0; k < n; k++) {
+		frozen_ids[origins[k]] = k;
+		degrees[k] = list[origins[k]];
+	}
+}
+void FrozenMSG::set_vectors(const std::vector<const BitSeq *> & vecs) {
+	size_t n = vecs.size(); stride = 0;
+	for (size_t k = 0; k < n; k++) 
+		stride = std::max(stride, (size_t)vecs[k]->word_number());
+	words.assign(n * stride, 0);
+
+	/* no reallocation after the views are created, where copies would own their words */
+	vectors.reserve(n);
+	for (size_t k = 0; k < n; k++) {
+		const BitSeq & vec = *(vecs[origins[k]]);
+		word * block = words.data() + k * stride;
+		std::copy(vec.get_words(), vec.get_words() + vec.word_number(), block);
+
+		/* clear the padding bits in the last word */
+		BitSeq::size_t rest = vec.bit_number() % WORD_BITS;
+		if (rest != 0) block[vec.word_number() - 1] &= (((word)1) << rest) - 1;
+
+		vectors.emplace_back(vec.bit_number(), block);
+	}
+}
+void FrozenMSG::set_edges(std::vector<std::pair<ID, ID>> & edges) {
+	size_t n = size(), m = edges.size();
+	std::sort(edges.begin(), edges.end());
+
+	/* count edges of each node */
+	ou_offsets.assign(n + 1, 0); in_offsets.assign(n + 1, 0);
+	for (size_t e = 0; e < m; e++) {
+		ou_offsets[edges[e].first + 1]++;
+		in_offsets[edges[e].second + 1]++;
+	}
+	for (size_t k = 0; k < n; k++) {
+		ou_offsets[k + 1] += ou_offsets[k];
+		in_offsets[k + 1] += in_offsets[k];
+	}
+
+	/* fill the ranges (in increasing ids as edges are sorted) */
+	ou_targets.resize(m); in_sources.resize(m);
+	std::vector<size_t> in_next(in_offsets.begin(), in_offsets.end() - 1);
+	for (size_t e = 0; e < m; e++) {
+		ou_targets[e] = edges[e].second;
+		in_sources[in_next[edges[e].second]++] = edges[e].first;
+	}
+}
+void FrozenMSG::set_mutants(const std::vector<std::pair<Mutant::ID, ID>> & pairs) {
+	size_t n = size(), m = pairs.size();
+
+	mut_offsets.assign(n + 1, 0);
+	for (size_t k = 0; k < m; k++) mut_offsets[pairs[k].second + 1]++;
+	for (size_t k = 0; k < n; k++) mut_offsets[k + 1] += mut_offsets[k];
+
+	mutants.resize(m);
+	mut_nodes.assign(m == 0 ? 0 : pairs[m - 1].first + 1, (ID)n);
+	std::vector<size_t> next(mut_offsets.begin(), mut_offsets.end() - 1);
+	for (size_t k = 0; k < m; k++) {
+		mutants[next[pairs[k].second]++] = pairs[k].first;
+		mut_nodes[pairs[k].first] = pairs[k].second;
+	}
+}
+
+/* FrozenPort */
+FrozenNode FrozenPort::get_node(size_t k) const {
+	if (k >= degree()) {
+		CError error(CErrorType::OutOfIndex, "FrozenPort::get_node", 
+			"Invalid index (" + std::to_string(k) + ")");
+		CErrorConsumer::consume(error); exit(CErrorType::OutOfIndex);
+	}
+	else return FrozenNode(*graph, first[k]);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+/*
+	file : fgraph.h
+	purp : to define the immutable form of a built MS_Graph | MSGraph in compressed-sparse-row arrays
+	date : oct 16th 2026
+	clas :
+		[1] FrozenMSG
+		[2] FrozenPort
+		[3] FrozenNode
+*/
+
+#include "sgraph.h"
+#include "mgraph.h"
+#include "bitkern.h"
+
+class FrozenMSG;
+class FrozenPort;
+class FrozenNode;
+
+/*
+*	Read-only copy of a built graph, where nodes are numbered in order of their score
+*	degrees (so that all edges point from lower id to higher id), the edges out of | into
+*	each node are ranges in two contiguous arrays, the score vectors are stored in one
+*	block of words (of the same stride), and the mutants of each node are a sorted range.
+*	Nodes are accessed by value as FrozenNode, whose accessors match MSG_Node | MuCluster.
+*/
+class FrozenMSG {
+public:
+	/* type of node id in frozen graph */
+	typedef unsigned int ID;
+
+	/* create an empty frozen graph */
+	FrozenMSG() : stride(0), words(), vectors(), degrees(), origins(), frozen_ids(),
+		ou_offsets(), ou_targets(), in_offsets(), in_sources(), mut_offsets(), mutants(), mut_nodes() {}
+	/* deconstructor */
+	~FrozenMSG() { clear(); }
+
+	/* rebuild this as the frozen form of a built MS_Graph */
+	bool freeze(const MS_Graph &);
+	/* rebuild this as the frozen form of a built MSGraph */
+	bool freeze(const MSGraph &);
+	/* delete all the nodes, edges and vectors */
+	void clear();
+
+	/* get the number of nodes in the graph */
+	size_t size() const { return degrees.size(); }
+	/* get the number of edges in the graph */
+	size_t number_of_edges() const { return ou_targets.size(); }
+	/* get the number of mutants in the graph */
+	size_t size_of_mutants() const { return mutants.size(); }
+
+	/* get the node by its id in the frozen graph */
+	FrozenNode get_node(ID) const;
+	/* get the node of the MSG_Node | MuCluster of specified id in the graph frozen */
+	FrozenNode get_node_of_origin(long) const;
+	/* whether there is node for the mutant in the graph */
+	bool has_node_of(Mutant::ID mid) const { return mid < mut_nodes.size() && mut_nodes[mid] < size(); }
+	/* get the node to which the mutant belongs */
+	FrozenNode get_node_of(Mutant::ID) const;
+
+	/* whether the score vector of x subsumes that of y (compared over their words in block) */
+	bool subsume(ID x, ID y) const { 
+		return BitKernel::get().subsume(words.data() + x * stride, words.data() + y * stride, stride); 
+	}
+
+	/* read the arrays */
+	friend class FrozenNode;
+	friend class FrozenPort;
+
+private:
+	/* number of words for each score vector */
+	size_t stride;
+	/* score vectors of all nodes (node k at [k * stride, (k + 1) * stride)) */
+	std::vector<word> words;
+	/* views of score vectors over words (not released by themselves) */
+	std::vector<BitSeq> vectors;
+	/* score degree of each node */
+	std::vector<BitSeq::size_t> degrees;
+
+	/* id of the node in the graph frozen, for each node */
+	std::vector<long> origins;
+	/* id of frozen node, for each node in the graph frozen */
+	std::vector<ID> frozen_ids;
+
+	/* edges out from node k are ou_targets[ou_offsets[k], ou_offsets[k + 1]) */
+	std::vector<size_t> ou_offsets;
+	std::vector<ID> ou_targets;
+	/* edges into node k are in_sources[in_offsets[k], in_offsets[k + 1]) */
+	std::vector<size_t> in_offsets;
+	std::vector<ID> in_sources;
+
+	/* mutants of node k are mutants[mut_offsets[k], mut_offsets[k + 1]) in increasing order */
+	std::vector<size_t> mut_offsets;
+	std::vector<Mutant::ID> mutants;
+	/* node of each mutant (size() if not in graph) */
+	std::vector<ID> mut_nodes;
+
+	/* number the nodes of graph frozen in order of their degrees (stable by their origin ids) */
+	void order_nodes(const std::vector<size_t> & degrees);
+	/* copy the score vectors of graph frozen (by origin ids) into the block of words */
+	void set_vectors(const std::vector<const BitSeq *> & vectors);
+	/* build up the out- and in-edges from (source, target) pairs of frozen ids */
+	void set_edges(std::vector<std::pair<ID, ID>> & edges);
+	/* build up the mutants of nodes from (mutant, frozen id) pairs in increasing order of mutants */
+	void set_mutants(const std::vector<std::pair<Mutant::ID, ID>> & pairs);
+
+	/* graph cannot be copied */
+	FrozenMSG(const FrozenMSG &) = delete;
+	FrozenMSG & operator = (const FrozenMSG &) = delete;
+};
+/* read-only edges from | to a node in frozen graph, as a range of node ids */
+class FrozenPort {
+public:
+	/* create the port over ids in [first, last) */
+	FrozenPort(const FrozenMSG & g, const FrozenMSG::ID * first, const FrozenMSG::ID * last) :
+		graph(&g), first(first), last(last) {}
+
+	/* number of edges in the port */
+	size_t degree() const { return last - first; }
+	/* get the node at the other end of the kth edge */
+	FrozenNode get_node(size_t) const;
+
+	/* ids of the nodes at the other ends */
+	const FrozenMSG::ID * begin() const { return first; }
+	const FrozenMSG::ID * end() const { return last; }
+
+private:
+	const FrozenMSG * graph;
+	const FrozenMSG::ID * first;
+	const FrozenMSG::ID * last;
+};
+/* read-only node in frozen graph */
+class FrozenNode {
+public:
+	/* create the node of id in graph */
+	FrozenNode(const FrozenMSG & g, FrozenMSG::ID k) : graph(&g), id(k) {}
+
+	/* get the graph where the node is defined */
+	const FrozenMSG & get_graph() const { return *graph; }
+	/* get the integer id of this node in frozen graph */
+	FrozenMSG::ID get_node_id() const { return id; }
+	/* get the id of MSG_Node | MuCluster from which the node is frozen (as numbered when frozen) */
+	long get_origin_id() const { return graph->origins[id]; }
+
+	/* get the number of mutants in this node */
+	size_t size() const { return graph->mut_offsets[id + 1] - graph->mut_offsets[id]; }
+	/* get the kth mutant in this node (in increasing order) */
+	Mutant::ID get_mutant(size_t k) const { return graph->mutants[graph->mut_offsets[id] + k]; }
+	/* whether the mutant is in this node */
+	bool has_mutant(Mutant::ID mid) const { return graph->has_node_of(mid) && graph->mut_nodes[mid] == id; }
+
+	/* score vector for mutants in this node */
+	const BitSeq & get_score_vector() const { return graph->vectors[id]; }
+	/* score degree for mutants in this node */
+	BitSeq::size_t get_score_degree() const { return graph->degrees[id]; }
+
+	/* edges into this node */
+	FrozenPort get_in_port() const {
+		const FrozenMSG::ID * list = graph->in_sources.data();
+		return FrozenPort(*graph, list + graph->in_offsets[id], list + graph->in_offsets[id + 1]);
+	}
+	/* edges out from this node */
+	FrozenPort get_ou_port() const {
+		const FrozenMSG::ID * list = graph->ou_targets.data();
+		return FrozenPort(*graph, list + graph->ou_offsets[id], list + graph->ou_offsets[id + 1]);
+	}
+
+private:
+	const FrozenMSG * graph;
+	FrozenMSG::ID id;
+};
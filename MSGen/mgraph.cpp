@@ -3,22 +3,12 @@
 
 unsigned int times;
 
-MuCluster::MuCluster(MSGraph & g, MuCluster::ID id, const BitSeq & bits)
-	: graph(g), cluster_id(id), score_vector(bits), score_degree(0) {
-	MutantSpace & mspace = graph.get_space();
-	mutants = mspace.create_set();
-	in_port = new MuSubsumePort();
-	ou_port = new MuSubsumePort();
-
-	BitSeq::size_t i = 0, n = bits.bit_number();
-	while (i < n) {
-		if (score_vector.get_bit(i++) == BIT_1)
-			score_degree++;
-	}
-}
-MuCluster::~MuCluster() {
-	delete in_port;
-	delete ou_port;
+MuCluster::MuCluster(MSGraph & g, MuCluster::ID id, const BitSeq & bits, MemoryArena & arena)
+	: graph(g), cluster_id(id), mutants(g.get_space(), &arena), 
+	score_vector(bits.bit_number(), BitSeq::copy_words(arena, bits)), score_degree(0) {
+	in_port = new (arena.allocate(sizeof(MuSubsumePort), alignof(MuSubsumePort))) MuSubsumePort(arena);
+	ou_port = new (arena.allocate(sizeof(MuSubsumePort), alignof(MuSubsumePort))) MuSubsumePort(arena);
+	score_degree = score_vector.degree();
 }
 void MuCluster::link_to(MuCluster & trg) {
 	if (&trg == this) {
@@ -115,8 +105,8 @@ void MSGraph::clear() {
 	mutants->clear();
 
 	for (size_t i = 0; i < clusters.size(); i++)
-		delete clusters[i];
-	clusters.clear();
+		clusters[i]->mutants.clear();
+	clusters.clear(); arena.clear();
 }
 void MSGraph::clear_edges() {
 	size_t i, n = clusters.size();
@@ -127,7 +117,8 @@ void MSGraph::clear_edges() {
 	}
 }
 MuCluster * MSGraph::new_cluster(const BitSeq & bits) {
-	MuCluster * cluster = new MuCluster(*this, clusters.size(), bits);
+	MuCluster * cluster = new (arena.allocate(sizeof(MuCluster), alignof(MuCluster))) 
+		MuCluster(*this, clusters.size(), bits, arena);
 	clusters.push_back(cluster); hierarchy.add(*cluster);
 	return cluster;
 }
@@ -163,13 +154,17 @@ void MSGraph::update_roots_and_leafs() {
 
 _MSG_VSpace_down_top::~_MSG_VSpace_down_top() {
 	while (!vqueue.empty()) vqueue.pop();
-	while (!vcache.empty()) vcache.pop();
-	visitset.clear();
+	vstack.clear(); visitset.clear();
+	counters.clear(); records.clear();
 }
 void _MSG_VSpace_down_top::initial() {
 	while (!vqueue.empty()) vqueue.pop();
-	while (!vcache.empty()) vcache.pop();
-	visitset.clear();
+	if (records.size() != adset.size()) {
+		visitset.assign(adset.size(), unvisited);
+		counters.assign(adset.size(), 0);
+		records.assign(adset.size(), 0); round = 0;
+	}
+	round++;	/* states and counters of last round are out of date */
 
 	auto beg = leafs.begin();
 	auto end = leafs.end();
@@ -178,113 +173,93 @@ void _MSG_VSpace_down_top::initial() {
 		vqueue.push(x);
 	}
 }
-void _MSG_VSpace_down_top::visit_subsuming(MuCluster * x) {
-	/* declarations */
-	std::queue<MuCluster *> bfs_queue;
-	std::set<MuCluster *> visit_set;
+void _MSG_VSpace_down_top::touch(MuCluster * x) {
+	MuCluster::ID k = x->get_id();
+	if (records[k] == round) return;
 
-	/* initialization */
-	bfs_queue.push(x); visit_set.insert(x);
+	/* count the children of x in sub-graph */
+	const MuSubsumePort::EdgeList & edges
+		= x->get_ou_port().get_edges();
+	auto beg = edges.begin(), end = edges.end();
+	unsigned int count = 0;
+	while (beg != end) {
+		const MuSubsume & edge = *(beg++);
+		if (adset[edge.get_target().get_id()]) count++;
+	}
 
-	/* iterate by BFS from x to its parents or parents' parents */
-	while (!bfs_queue.empty()) {
+	records[k] = round; visitset[k] = unvisited; counters[k] = count;
+}
+void _MSG_VSpace_down_top::visit_subsuming(MuCluster * x) {
+	/* iterate by DFS from x to its parents or parents' parents */
+	vstack.clear(); vstack.push_back(x);
+	while (!vstack.empty()) {
 		/* get next node to be removed from VS */
-		x = bfs_queue.front(); bfs_queue.pop();
+		x = vstack.back(); vstack.pop_back();
 
 		/* get edges from parents to x */
-		const std::vector<MuSubsume> & edges
+		const MuSubsumePort::EdgeList & edges
 			= x->get_in_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
 		while(beg != end) {
-			/* get next unvisited parent */
+			/* get next parent in sub-graph */
 			const MuSubsume & edge = *(beg++);
 			MuCluster & parent = edge.get_source();
-			if (visit_set.count(&parent) > 0) continue;
+			if (!adset[parent.get_id()]) continue;
 
-			/* set parent as visited */
-			visitset.insert(&parent);
+			/* parent and its ancestors have been visited */
+			touch(&parent);
+			VState & state = visitset[parent.get_id()];
+			if (state == above) continue;
 
-			/* update the bfs_queue */
-			bfs_queue.push(&parent);
-			visit_set.insert(&parent);
+			/* set parent as visited */
+			state = above; vstack.push_back(&parent);
 		}
-	} /* end while: bfs_queue */
+	} /* end while: vstack */
 
 	/* return */ return;
 }
-bool _MSG_VSpace_down_top::accessible(MuCluster * x) {
-	if (adset.count(x) == 0) return false;			/* not in the sub-graph */
-	else if (visitset.count(x) > 0) return false;	/* have been visited */
-	else {
-		/* get the edges from x to its direct children */
-		const std::vector<MuSubsume> & edges
-			= x->get_ou_port().get_edges();
+MuCluster * _MSG_VSpace_down_top::next() {
+	while (!vqueue.empty()) {
+		/* get the next node whose children have been visited */
+		MuCluster * next = vqueue.front(); vqueue.pop();
+		touch(next); 
+		if (visitset[next->get_id()] != unvisited) continue;
+		else visitset[next->get_id()] = visited;
+
+		/* parents become accessible when all their children are visited */
+		const MuSubsumePort::EdgeList & edges
+			= next->get_in_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
-
-		/* validate the x's children */
 		while (beg != end) {
-			/* get next child in sub-graph */
 			const MuSubsume & edge = *(beg++);
-			MuCluster & child = edge.get_target();
-			if (adset.count(&child) == 0) continue;
+			MuCluster & parent = edge.get_source();
+			if (!adset[parent.get_id()]) continue;
 
-			/* child is not visited yet */
-			if (visitset.count(&child) == 0)
-				return false;
+			touch(&parent);
+			if (--counters[parent.get_id()] == 0 
+				&& visitset[parent.get_id()] == unvisited)
+				vqueue.push(&parent);
 		}
-		return true;	/* all children have been visited */
-	}
-}
-MuCluster * _MSG_VSpace_down_top::next() {
-	MuCluster * next = nullptr;
-	while (next == nullptr && !vqueue.empty()) {
-		/* compute the next unvisited node in sub-graph */
-		while (!vqueue.empty()) {
-			next = vqueue.front(); 
-			vqueue.pop(); vcache.push(next);
-
-			if (visitset.count(next) == 0) {
-				visitset.insert(next); 
-				break;
-			}
-			else next = nullptr;
-		} /* end while: vqueue */
-
-		/* update vqueue from vcache */
-		std::set<MuCluster *> records;
-		while (!vcache.empty()) {
-			MuCluster * x = vcache.front(); vcache.pop();
-
-			const std::vector<MuSubsume> & edges
-				= x->get_in_port().get_edges();
-			auto beg = edges.begin(), end = edges.end();
-			
-			while (beg != end) {
-				/* get next un-iterated parent */
-				const MuSubsume & edge = *(beg++);
-				MuCluster & parent = edge.get_source();
-				if (records.count(&parent) > 0) continue;
-				else records.insert(&parent);
-
-				if (accessible(&parent))
-					vqueue.push(&parent);
-			}
-		} /* end while: vcache */
 
+		return next;
 	} /* end while */
 
-	/* no more unvisited node */ return next;
+	/* no more unvisited node */ return nullptr;
 }
 
 _MSG_VSpace_top_down::~_MSG_VSpace_top_down() {
 	while (!vqueue.empty()) vqueue.pop();
-	while (!vcache.empty()) vcache.pop();
-	visitset.clear();
+	vstack.clear(); visitset.clear();
+	counters.clear(); records.clear();
 }
 void _MSG_VSpace_top_down::initial() {
 	while (!vqueue.empty()) vqueue.pop();
-	while (!vcache.empty()) vcache.pop();
-	visitset.clear();
+	if (records.size() != adset.size()) {
+		visitset.assign(adset.size(), unvisited);
+		counters.assign(adset.size(), 0);
+		records.assign(adset.size(), 0); round = 0;
+	}
+	round++;	/* states and counters of last round are out of date */
 
 	auto beg = roots.begin();
 	auto end = roots.end();
@@ -293,198 +268,168 @@ void _MSG_VSpace_top_down::initial() {
 		vqueue.push(x);
 	}
 }
-void _MSG_VSpace_top_down::visit_subsumed(MuCluster * x) {
-	/* declarations */
-	std::queue<MuCluster *> bfs_queue;
-	std::set<MuCluster *> visit_set;
+void _MSG_VSpace_top_down::touch(MuCluster * x) {
+	MuCluster::ID k = x->get_id();
+	if (records[k] == round) return;
 
-	/* initialization */
-	bfs_queue.push(x); visit_set.insert(x);
+	/* count the parents of x in sub-graph */
+	const MuSubsumePort::EdgeList & edges
+		= x->get_in_port().get_edges();
+	auto beg = edges.begin(), end = edges.end();
+	unsigned int count = 0;
+	while (beg != end) {
+		const MuSubsume & edge = *(beg++);
+		if (adset[edge.get_source().get_id()]) count++;
+	}
 
-	/* iterate by BFS from x to its parents or parents' parents */
-	while (!bfs_queue.empty()) {
+	records[k] = round; visitset[k] = unvisited; counters[k] = count;
+}
+void _MSG_VSpace_top_down::visit_subsumed(MuCluster * x) {
+	/* iterate by DFS from x to its children or children's children */
+	vstack.clear(); vstack.push_back(x);
+	while (!vstack.empty()) {
 		/* get next node to be removed from VS */
-		x = bfs_queue.front(); bfs_queue.pop();
+		x = vstack.back(); vstack.pop_back();
 
 		/* get edges from x to its children */
-		const std::vector<MuSubsume> & edges
+		const MuSubsumePort::EdgeList & edges
 			= x->get_ou_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
 		while (beg != end) {
-			/* get next unvisited parent */
+			/* get next child in sub-graph */
 			const MuSubsume & edge = *(beg++);
 			MuCluster & child = edge.get_target();
-			if (visit_set.count(&child) > 0) continue;
+			if (!adset[child.get_id()]) continue;
 
-			/* set parent as visited */
-			visitset.insert(&child);
+			/* child and its descendants have been visited */
+			touch(&child);
+			VState & state = visitset[child.get_id()];
+			if (state == below) continue;
 
-			/* update the bfs_queue */
-			bfs_queue.push(&child);
-			visit_set.insert(&child);
+			/* set child as visited */
+			state = below; vstack.push_back(&child);
 		}
-	} /* end while: bfs_queue */
+	} /* end while: vstack */
 
 	/* return */ return;
 }
-bool _MSG_VSpace_top_down::accessible(MuCluster * x) {
-	if (adset.count(x) == 0) return false;		/* not in sub-graph */
-	else if (visitset.count(x) > 0) return false;	/* have been visited */
-	else {
-		const std::vector<MuSubsume> & edges
-			= x->get_in_port().get_edges();
+MuCluster * _MSG_VSpace_top_down::next() {
+	while (!vqueue.empty()) {
+		/* get the next node whose parents have been visited */
+		MuCluster * next = vqueue.front(); vqueue.pop();
+		touch(next);
+		if (visitset[next->get_id()] != unvisited) continue;
+		else visitset[next->get_id()] = visited;
+
+		/* children become accessible when all their parents are visited */
+		const MuSubsumePort::EdgeList & edges
+			= next->get_ou_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
-		
 		while (beg != end) {
-			/* get next parent in sub-graph */
 			const MuSubsume & edge = *(beg++);
-			MuCluster & parent = edge.get_source();
-			if (adset.count(&parent) == 0) continue;
+			MuCluster & child = edge.get_target();
+			if (!adset[child.get_id()]) continue;
 
-			/* not visited, then not accessible */
-			if (visitset.count(&parent) == 0)
-				return false;
+			touch(&child);
+			if (--counters[child.get_id()] == 0 
+				&& visitset[child.get_id()] == unvisited)
+				vqueue.push(&child);
 		}
-		return true;
-	}
-}
-MuCluster * _MSG_VSpace_top_down::next() {
-	MuCluster * next = nullptr;
-	while (next == nullptr && !vqueue.empty()) {
-		/* compute the next unvisited node in sub-graph */
-		while (!vqueue.empty()) {
-			next = vqueue.front();
-			vqueue.pop(); vcache.push(next);
-
-			if (visitset.count(next) == 0) {
-				visitset.insert(next);
-				break;
-			}
-			else next = nullptr;
-		} /* end while: vqueue */
-
-		  /* update vqueue from vcache */
-		std::set<MuCluster *> records;
-		while (!vcache.empty()) {
-			MuCluster * x = vcache.front();
-			vcache.pop();
-
-			const std::vector<MuSubsume> & edges
-				= x->get_ou_port().get_edges();
-			auto beg = edges.begin(), end = edges.end();
-			while (beg != end) {
-				/* get next un-iterated parent */
-				const MuSubsume & edge = *(beg++);
-				MuCluster & child = edge.get_target();
-				if (records.count(&child) > 0) continue;
-				else records.insert(&child);
-
-				if (accessible(&child))
-					vqueue.push(&child);
-			}
-		} /* end while: vcache */
 
+		return next;
 	} /* end while */
 
-	/* no more unvisited node */ return next;
+	/* no more unvisited node */ return nullptr;
 }
 
 _MSG_VSpace_randomly::~_MSG_VSpace_randomly() {
-	visitset.clear();
+	vstack.clear(); visitset.clear(); records.clear();
 }
 void _MSG_VSpace_randomly::initial() {
-	visitset.clear();
-	auto beg = adset.begin(), end = adset.end();
-	while (beg != end) visitset.insert(*(beg++));
+	if (records.size() != adset.size()) {
+		visitset.assign(adset.size(), unvisited);
+		records.assign(adset.size(), 0); round = 0;
+	}
+	round++; cursor = 0;	/* states of last round are out of date */
 }
 void _MSG_VSpace_randomly::visit_subsumed(MuCluster * x) {
-	/* declarations */
-	std::queue<MuCluster *> bfs_queue;
-	std::set<MuCluster *> visit_set;
-
-	/* initialization */
-	bfs_queue.push(x); visit_set.insert(x);
-
-	/* iterate by BFS from x to its parents or parents' parents */
-	while (!bfs_queue.empty()) {
+	/* iterate by DFS from x to its children or children's children */
+	vstack.clear(); vstack.push_back(x);
+	while (!vstack.empty()) {
 		/* get next node to be removed from VS */
-		x = bfs_queue.front(); bfs_queue.pop();
+		x = vstack.back(); vstack.pop_back();
 
 		/* get edges from x to its children */
-		const std::vector<MuSubsume> & edges
+		const MuSubsumePort::EdgeList & edges
 			= x->get_ou_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
 		while (beg != end) {
-			/* get next unvisited parent */
+			/* get next child in sub-graph */
 			const MuSubsume & edge = *(beg++);
 			MuCluster & child = edge.get_target();
-			if (visit_set.count(&child) > 0) continue;
+			if (!adset[child.get_id()]) continue;
 
-			/* set parent as visited */
-			if(visitset.count(&child) > 0)
-				visitset.erase(&child);
+			/* child and its descendants have been visited */
+			VState & state = state_of(child.get_id());
+			if (state & below) continue;
 
-			/* update the bfs_queue */
-			bfs_queue.push(&child);
-			visit_set.insert(&child);
+			/* set child as visited */
+			state |= below; vstack.push_back(&child);
 		}
-	} /* end while: bfs_queue */
+	} /* end while: vstack */
 
 	/* return */ return;
 }
 void _MSG_VSpace_randomly::visit_subsuming(MuCluster * x) {
-	/* declarations */
-	std::queue<MuCluster *> bfs_queue;
-	std::set<MuCluster *> visit_set;
-
-	/* initialization */
-	bfs_queue.push(x); visit_set.insert(x);
-
-	/* iterate by BFS from x to its parents or parents' parents */
-	while (!bfs_queue.empty()) {
+	/* iterate by DFS from x to its parents or parents' parents */
+	vstack.clear(); vstack.push_back(x);
+	while (!vstack.empty()) {
 		/* get next node to be removed from VS */
-		x = bfs_queue.front(); bfs_queue.pop();
+		x = vstack.back(); vstack.pop_back();
 
 		/* get edges from parents to x */
-		const std::vector<MuSubsume> & edges
+		const MuSubsumePort::EdgeList & edges
 			= x->get_in_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
 		while (beg != end) {
-			/* get next unvisited parent */
+			/* get next parent in sub-graph */
 			const MuSubsume & edge = *(beg++);
 			MuCluster & parent = edge.get_source();
-			if (visit_set.count(&parent) > 0) continue;
+			if (!adset[parent.get_id()]) continue;
 
-			/* set parent as visited */
-			if (visitset.count(&parent) > 0)
-				visitset.erase(&parent);
+			/* parent and its ancestors have been visited */
+			VState & state = state_of(parent.get_id());
+			if (state & above) continue;
 
-			/* update the bfs_queue */
-			bfs_queue.push(&parent);
-			visit_set.insert(&parent);
+			/* set parent as visited */
+			state |= above; vstack.push_back(&parent);
 		}
-	} /* end while: bfs_queue */
+	} /* end while: vstack */
 
 	/* return */ return;
 }
 MuCluster * _MSG_VSpace_randomly::next() {
-	MuCluster * next = nullptr;
-	if (!visitset.empty()) {
-		auto beg = visitset.begin();
-		next = *(beg);
-		visitset.erase(next);
+	/* get the next node in sub-graph not visited yet (by its id) */
+	while (cursor < adset.size()) {
+		MuCluster::ID k = cursor++;
+		if (adset[k] && state_of(k) == unvisited) {
+			visitset[k] = visited;
+			return &(graph.get_cluster(k));
+		}
 	}
-	return next;
+	return nullptr;
 }
 
 void MSGLinker::connect(MSGraph & g, OrderOption opt) {
 	const MuHierarchy & hierarchy = g.get_hierarchy();
 	int i, n = hierarchy.size_of_degress();
 	std::map<MuCluster *, std::set<MuCluster *> *> solutions;
+	ThreadPool * pool = nullptr;
 
 	/* efficiency analysis */ times = 0;
 
 	this->open(g, opt);
+	if (threads != 1) pool = new ThreadPool(threads);
 	for (i = n - 1; i >= 0; i--) {
 		/* get level at H[k] */
 		const std::set<MuCluster *> & level 
@@ -492,11 +437,15 @@ void MSGLinker::connect(MSGraph & g, OrderOption opt) {
 		auto beg = level.begin(), end = level.end();
 
 		/* compute DS for each x in H[k] */
-		while (beg != end) {
-			MuCluster * x = *(beg++);
-			std::set<MuCluster *> * DS = new std::set<MuCluster *>();
-			compute_direct_subsumption(*x, *DS);
-			solutions[x] = DS;
+		if (pool != nullptr && level.size() > 1)
+			compute_direct_subsumption(*pool, opt, level, solutions);
+		else {
+			while (beg != end) {
+				MuCluster * x = *(beg++);
+				std::set<MuCluster *> * DS = new std::set<MuCluster *>();
+				compute_direct_subsumption(*x, *DS);
+				solutions[x] = DS;
+			}
 		}
 
 		/* connect x to its DS */
@@ -512,19 +461,24 @@ void MSGLinker::connect(MSGraph & g, OrderOption opt) {
 		/* add nodes in H[k] to subgraph */
 		add_nodes_in(level);
 	}
+	if (pool != nullptr) delete pool;
 	this->close();
 }
 void MSGLinker::open(MSGraph & g, OrderOption opt) {
 	close(); graph = &g; g.clear_edges();
+	adset.assign(g.size(), 0);
+	vspace = new_vspace(opt);
+}
+_MSG_VSpace * MSGLinker::new_vspace(OrderOption opt) {
 	switch (opt) {
 	case down_top:
-		vspace = new _MSG_VSpace_down_top(adset, leafs); break;
+		return new _MSG_VSpace_down_top(adset, leafs);
 	case top_down:
-		vspace = new _MSG_VSpace_top_down(adset, roots); break;
+		return new _MSG_VSpace_top_down(adset, roots);
 	case randomly:
-		vspace = new _MSG_VSpace_randomly(adset); break;
+		return new _MSG_VSpace_randomly(*graph, adset);
 	default:
-		CError error(CErrorType::InvalidArguments, "MSGLinker::open", 
+		CError error(CErrorType::InvalidArguments, "MSGLinker::new_vspace", 
 			"Unknown option (" + std::to_string(opt) + ")");
 		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
 	}
@@ -560,7 +514,7 @@ void MSGLinker::add_nodes_in(const std::set<MuCluster *> & nodes) {
 	beg = nodes.begin(), end = nodes.end();
 	while (beg != end) {
 		MuCluster * x = *(beg++);
-		adset.insert(x);
+		adset[x->get_id()] = 1;
 
 		if (x->get_ou_port().get_degree() == 0)
 			leafs.insert(x);
@@ -569,19 +523,46 @@ void MSGLinker::add_nodes_in(const std::set<MuCluster *> & nodes) {
 	}
 }
 void MSGLinker::compute_direct_subsumption(MuCluster & x, std::set<MuCluster *> & DS) {
-	DS.clear(); vspace->initial(); MuCluster * y;
+	times += compute_direct_subsumption(*vspace, x, DS);	/* efficiency analysis */
+}
+size_t MSGLinker::compute_direct_subsumption(_MSG_VSpace & space, MuCluster & x, std::set<MuCluster *> & DS) {
+	DS.clear(); space.initial(); MuCluster * y; size_t comparisons = 0;
 
-	while ((y = vspace->next()) != nullptr) {
+	while ((y = space.next()) != nullptr) {
 		if (subsume(x, *y)) {
 			DS.insert(y);
-			vspace->visit_subsumed(y);
+			space.visit_subsumed(y);
 		}
-		else vspace->visit_subsuming(y);
+		else space.visit_subsuming(y);
 
-		times++;	/* efficiency analysis */
+		comparisons++;
 	}
 
 	eliminate_DS(DS);	/* eliminate redundant mutants */
+	return comparisons;
+}
+void MSGLinker::compute_direct_subsumption(ThreadPool & pool, OrderOption opt, 
+	const std::set<MuCluster *> & level, std::map<MuCluster *, std::set<MuCluster *> *> & solutions) {
+	std::vector<MuCluster *> nodes(level.begin(), level.end());
+	std::vector<std::set<MuCluster *> *> answers(nodes.size(), nullptr);
+
+	/* a few blocks for each worker, and each block with its own visit space */
+	size_t n = nodes.size(), blocks = pool.size() * 4;
+	if (blocks > n) blocks = n;
+	size_t step = (n + blocks - 1) / blocks; blocks = (n + step - 1) / step;
+	std::vector<size_t> comparisons(blocks, 0);
+	pool.parallel_for(blocks, [this, opt, n, step, &nodes, &answers, &comparisons](size_t b) {
+		_MSG_VSpace * space = new_vspace(opt);
+		for (size_t k = b * step; k < n && k < (b + 1) * step; k++) {
+			answers[k] = new std::set<MuCluster *>();
+			comparisons[b] += compute_direct_subsumption(*space, *(nodes[k]), *(answers[k]));
+		}
+		delete space;
+	});
+
+	/* merged in the order of level */
+	for (size_t k = 0; k < n; k++) solutions[nodes[k]] = answers[k];
+	for (size_t b = 0; b < blocks; b++) times += comparisons[b];	/* efficiency analysis */
 }
 bool MSGLinker::subsume(MuCluster & x, MuCluster & y) {
 	const BitSeq & xv = x.get_score_vector();
@@ -625,30 +606,107 @@ void MSGLinker::eliminate_DS(std::set<MuCluster *> & DS) {
 
 void MSGBuilder::open(MSGraph & g) {
 	close(); graph = &g; g.clear();
-	trie = new BitTrieTree();
+	index = BitIndex::create(strategy);
 }
 void MSGBuilder::add(Mutant::ID mid, const BitSeq & bits) {
-	if (graph == nullptr || trie == nullptr) {
+	if (graph == nullptr || index == nullptr) {
 		CError error(CErrorType::Runtime, "MSGBuilder::add", "Invalid access: not-opened");
 		CErrorConsumer::consume(error); exit(CErrorType::Runtime);
 	}
 	else {
-		/* find the leaf where the cluster is referred by bit-string */
-		BitTrie * leaf = trie->insert_vector(bits);
+		/* find the slot where the cluster is referred by bit-string */
+		void *& data = index->insert_vector(bits);
 
-		/* the first time to create cluster and insert it to the trie */
-		if (leaf->get_data() == nullptr) {
+		/* the first time to create cluster and insert it to the index */
+		if (data == nullptr) {
 			MuCluster * cluster = graph->new_cluster(bits);
 			graph->add_mutant(*cluster, mid); 
-			leaf->set_data(cluster);
+			data = cluster;
 		}
 		/* only to insert the mutant into the cluster */
 		else {
-			MuCluster * cluster = (MuCluster *)(leaf->get_data());
+			MuCluster * cluster = (MuCluster *)data;
 			graph->add_mutant(*cluster, mid);
 		}
 	}
 }
+void MSGBuilder::induce(const MSGraph & parent, const MutantSet & subset) {
+	if (graph == nullptr || index == nullptr) {
+		CError error(CErrorType::Runtime, "MSGBuilder::induce", "Invalid access: not-opened");
+		CErrorConsumer::consume(error); exit(CErrorType::Runtime);
+	}
+	else if (&(parent.get_space()) != &(graph->get_space()) || 
+		&(subset.get_space()) != &(graph->get_space()) || &parent == graph || graph->size() > 0) {
+		CError error(CErrorType::InvalidArguments, "MSGBuilder::induce", "Unmatched space or non-empty graph");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+
+	/* mutants in subset for each cluster in parent */
+	size_t n = parent.size();
+	std::vector<std::vector<Mutant::ID>> members(n);
+	const std::map<Mutant::ID, MuCluster *> & pindex = parent.get_index();
+	const BitSeq & svec = subset.get_set_vector();
+	const word * words = svec.get_words();
+	for (BitSeq::size_t i = 0; i < svec.word_number(); i++) {
+		word w = words[i];
+		while (w != 0) {
+			Mutant::ID mid = i * WORD_BITS + word_ctz(w); w &= w - 1;
+			if (mid >= svec.bit_number()) break;
+			auto iter = pindex.find(mid);
+			if (iter != pindex.end())
+				members[iter->second->get_id()].push_back(mid);
+		}
+	}
+
+	/* create the clusters by the order of parent clusters */
+	std::vector<long> local(n, -1); std::vector<MuCluster *> kept;
+	for (MuCluster::ID k = 0; k < n; k++) {
+		if (members[k].empty()) continue;
+		MuCluster & source = parent.get_cluster(k);
+		MuCluster * cluster = graph->new_cluster(source.get_score_vector());
+		index->insert_vector(source.get_score_vector()) = cluster;
+		local[k] = cluster->get_id(); kept.push_back(&source);
+		for (size_t j = 0; j < members[k].size(); j++)
+			graph->add_mutant(*cluster, members[k][j]);
+	}
+	graph->sort();
+
+	/* clusters left that are reachable from each one without passing the others */
+	size_t m = kept.size();
+	std::vector<std::vector<unsigned int>> next(m), direct;
+	std::vector<unsigned int> stamps(n, 0), order;
+	std::vector<MuCluster *> stack;
+	for (unsigned int x = 0; x < m; x++) {
+		stack.push_back(kept[x]);
+		while (!stack.empty()) {
+			MuCluster & y = *(stack.back()); stack.pop_back();
+			const MuSubsumePort::EdgeList & edges = y.get_ou_port().get_edges();
+			auto beg = edges.begin(), end = edges.end();
+			while (beg != end) {
+				MuCluster & z = (beg++)->get_target();
+				if (stamps[z.get_id()] == x + 1) continue;
+				stamps[z.get_id()] = x + 1;
+
+				if (local[z.get_id()] >= 0) next[x].push_back(local[z.get_id()]);
+				else stack.push_back(&z);
+			}
+		}
+	}
+
+	/* subsumed clusters (in higher levels of hierarchy) are reduced before their subsuming ones */
+	const MuHierarchy & hierarchy = graph->get_hierarchy();
+	for (size_t i = hierarchy.size_of_degress(); i > 0; i--) {
+		const std::set<MuCluster *> & level = hierarchy.get_clusters_at(i - 1);
+		auto beg = level.begin(), end = level.end();
+		while (beg != end) order.push_back((*(beg++))->get_id());
+	}
+	BitMatrix::reduce_transitive(next, order, direct);
+	for (unsigned int x = 0; x < m; x++) {
+		for (size_t k = 0; k < direct[x].size(); k++)
+			graph->connect(graph->get_cluster(x), graph->get_cluster(direct[x][k]));
+	}
+	graph->update_roots_and_leafs();
+}
 void MSGBuilder::link() {
 	graph->sort(); linker.connect(*graph);
 }
@@ -658,9 +716,14 @@ void MSGBuilder::link(MSGLinker::OrderOption option) {
 void MSGBuilder::close() {
 	if (graph != nullptr) {
 		graph = nullptr;
-		delete trie;
+		cluster_statistics = index->get_statistics();
+		delete index; index = nullptr;
 	}
 }
+const BitIndex::Statistics & MSGBuilder::get_clustering_statistics() const {
+	if (index != nullptr) return index->get_statistics();
+	else return cluster_statistics;
+}
 
 void MSGraphPrinter::write(MSGraph & graph) {
 	if (dir == nullptr) {
@@ -689,7 +752,7 @@ void MSGraphPrinter::write_mutant_graph(MSGraph & graph, std::ostream & out) {
 
 		out << cid << "\t" << degree << "\t";
 
-		const std::vector<MuSubsume> & edges = src.get_ou_port().get_edges();
+		const MuSubsumePort::EdgeList & edges = src.get_ou_port().get_edges();
 		auto beg = edges.begin(), end = edges.end();
 		while (beg != end) {
 			const MuSubsume & edge = *(beg++);
@@ -16,6 +16,8 @@
 */
 
 #include "cscore.h"
+#include "bitindex.h"
+#include "bitmatrix.h"
 #include <queue>
 
 // class declarations 
@@ -45,12 +47,14 @@ public:
 	/* get the id of this graph */
 	MuCluster::ID get_id() const { return cluster_id; }
 
-	/* get the mutant set of this cluster */
-	const MutantSet & get_mutants() const { return *mutants; }
+	/* get the mutant set of this cluster (created on demand) */
+	const MutantSet & get_mutants() const { return mutants.get_set(); }
+	/* get the ids of mutants in this cluster */
+	const MutantList & get_mutant_list() const { return mutants; }
 	/* whether there is mutant in the cluster */
-	bool has_mutant(Mutant::ID mid) const { return mutants->has_mutant(mid); }
+	bool has_mutant(Mutant::ID mid) const { return mutants.has_mutant(mid); }
 	/* get the number of mutants in this cluster */
-	size_t size() const { return mutants->number_of_mutants(); }
+	size_t size() const { return mutants.number_of_mutants(); }
 
 	/* get the score vector of this cluster */
 	const BitSeq & get_score_vector() const { return score_vector; }
@@ -71,8 +75,8 @@ private:
 	/* id of this cluster */
 	ID cluster_id;
 
-	/* class where mutant is stored */
-	MutantSet * mutants;
+	/* ids of mutants in this cluster */
+	MutantList mutants;
 
 	/* score vector of the cluster */
 	const BitSeq score_vector;
@@ -85,13 +89,13 @@ private:
 	MuSubsumePort * ou_port;
 
 protected:
-	/* create a cluster with specified cluster */
-	MuCluster(MSGraph &, ID, const BitSeq &);
-	/* deconstructor */
-	~MuCluster();
+	/* create a cluster with specified vector, whose vector, mutants and ports are kept in arena */
+	MuCluster(MSGraph &, ID, const BitSeq &, MemoryArena &);
+	/* deconstructor (never called as cluster is released with arena of graph) */
+	~MuCluster() {}
 
 	/* add mutant to the cluster */
-	void add_mutant(Mutant::ID mid) { mutants->add_mutant(mid); }
+	void add_mutant(Mutant::ID mid) { mutants.add_mutant(mid); }
 	/* link this node to another node */
 	void link_to(MuCluster &);
 };
@@ -123,9 +127,13 @@ private:
 };
 /* port to manage subsumption in cluster */
 class MuSubsumePort {
+public:
+	/* list of edges (in arena of graph) */
+	typedef std::vector<MuSubsume, ArenaAllocator<MuSubsume>> EdgeList;
+
 protected:
-	/* create an empty port */
-	MuSubsumePort() : edges() {}
+	/* create an empty port whose edges are kept in arena */
+	MuSubsumePort(MemoryArena & arena) : edges(ArenaAllocator<MuSubsume>(&arena)) {}
 	/* deconstructor */
 	~MuSubsumePort() { clear(); }
 
@@ -141,7 +149,7 @@ public:
 	/* get the number of edges in the port */
 	size_t get_degree() const { return edges.size(); }
 	/* get the list of edges in the port */
-	const std::vector<MuSubsume> & get_edges() const { return edges; }
+	const EdgeList & get_edges() const { return edges; }
 
 	/* create | delete | link */
 	friend class MuCluster;
@@ -149,7 +157,7 @@ public:
 	friend class MSGraph;
 
 private:
-	std::vector<MuSubsume> edges;
+	EdgeList edges;
 };
 /* mutant hierarchy */
 class MuHierarchy {
@@ -189,7 +197,7 @@ private:
 class MSGraph {
 public:
 	/* create an empty graph */
-	MSGraph(MutantSpace & space) : mspace(space), clusters(), hierarchy(), roots(), leafs(), index() { mutants = mspace.create_set(); }
+	MSGraph(MutantSpace & space) : mspace(space), arena(), clusters(), hierarchy(), roots(), leafs(), index() { mutants = mspace.create_set(); }
 	/* deconstructor */
 	~MSGraph() { clear(); mspace.delete_set(mutants); }
 
@@ -229,6 +237,8 @@ private:
 	MutantSpace & mspace;
 	/* set of all mutants in the graph */
 	MutantSet * mutants;
+	/* memory of clusters, and their vectors, mutants and ports */
+	MemoryArena arena;
 
 	/* set of nodes in the graph */
 	std::vector<MuCluster *> clusters;
@@ -244,7 +254,7 @@ private:
 	std::map<Mutant::ID, MuCluster *> index;
 
 protected:
-	/* clear all the nodes, edges and hierarchy */
+	/* clear all the nodes, edges and hierarchy (by releasing its arena at once) */
 	void clear();
 	/* create a new cluster for bit-string in this graph */
 	MuCluster * new_cluster(const BitSeq &);
@@ -289,6 +299,8 @@ protected:
 /* visit space for sub-graph in MSG */
 class _MSG_VSpace {
 public:
+	/* deconstructor */
+	virtual ~_MSG_VSpace() {}
 	/* initialize the visit space */
 	virtual void initial() {}
 	/* get the next unvisited node in sub-graph */
@@ -297,6 +309,16 @@ public:
 	virtual void visit_subsuming(MuCluster *x) {}
 	/* tag all those subsumed by x in sub-graph as visited */
 	virtual void visit_subsumed(MuCluster *x) {}
+
+protected:
+	/* state of node in the visit space (indexed by MuCluster::ID) */
+	typedef char VState;
+	enum {
+		unvisited = 0,	/* not visited yet */
+		visited = 1,	/* returned by next() */
+		above = 2,		/* it and all those subsuming it are visited */
+		below = 4,		/* it and all those subsumed by it are visited */
+	};
 };
 /* to iterate unvisited nodes in subgraph of MSG from leafs to roots */
 class _MSG_VSpace_down_top : public _MSG_VSpace {
@@ -314,30 +336,32 @@ public:
 	friend class MSGLinker;
 protected:
 	/* create a visit space for sub-graph from leafs to the roots */
-	_MSG_VSpace_down_top(const std::set<MuCluster *> & as, 
-		const std::set<MuCluster *> & lf) : adset(as), leafs(lf) {}
+	_MSG_VSpace_down_top(const std::vector<char> & as, 
+		const std::set<MuCluster *> & lf) : adset(as), leafs(lf), round(0) {}
 	/* deconstructor */
 	~_MSG_VSpace_down_top();
 
 private:
-	/* set of nodes in sub-graph */
-	const std::set<MuCluster *> & adset;
+	/* whether each node is in sub-graph */
+	const std::vector<char> & adset;
 	/* leafs in sub-graph */
 	const std::set<MuCluster *> & leafs;
 
-	/* queue for visited node in current iteration */
+	/* nodes whose children in sub-graph have all been visited */
 	std::queue<MuCluster *> vqueue;
-	/* cache for updatng vqueue in next iteration */
-	std::queue<MuCluster *> vcache;
-	/* set of nodes that have been (tagged as) visited */
-	std::set<MuCluster *> visitset;
-
-	/* a node is accessible when:
-		1) it is in the subgraph
-		2) it is not visited yet
-		3) all of its children have been visited
-	*/
-	bool accessible(MuCluster *);
+	/* stack for tagging the nodes subsuming x */
+	std::vector<MuCluster *> vstack;
+	/* state of each node in current round */
+	std::vector<VState> visitset;
+	/* number of unvisited children in sub-graph for each node in current round */
+	std::vector<unsigned int> counters;
+	/* round in which the state and counter of each node are set */
+	std::vector<size_t> records;
+	/* round of initial() */
+	size_t round;
+
+	/* set the state and counter of the node when it is first touched in this round */
+	void touch(MuCluster *);
 };
 /* to iterate unvisited nodes in subgraph of MSG from roots to leafs */
 class _MSG_VSpace_top_down : public _MSG_VSpace {
@@ -355,30 +379,32 @@ public:
 	friend class MSGLinker;
 protected:
 	/* create a visit space for sub-graph from leafs to the roots */
-	_MSG_VSpace_top_down(const std::set<MuCluster *> & as,
-		const std::set<MuCluster *> & rt) : adset(as), roots(rt) {}
+	_MSG_VSpace_top_down(const std::vector<char> & as,
+		const std::set<MuCluster *> & rt) : adset(as), roots(rt), round(0) {}
 	/* deconstructor */
 	~_MSG_VSpace_top_down();
 
 private:
-	/* set of nodes in sub-graph */
-	const std::set<MuCluster *> & adset;
+	/* whether each node is in sub-graph */
+	const std::vector<char> & adset;
 	/* leafs in sub-graph */
 	const std::set<MuCluster *> & roots;
 
-	/* queue for visited node in current iteration */
+	/* nodes whose parents in sub-graph have all been visited */
 	std::queue<MuCluster *> vqueue;
-	/* cache for updatng vqueue in next iteration */
-	std::queue<MuCluster *> vcache;
-	/* set of nodes that have been (tagged as) visited */
-	std::set<MuCluster *> visitset;
-
-	/* a node is accessible when:
-		1) it is in the subgraph
-		2) it is not visited yet
-		3) all of its parents have been visited
-	*/
-	bool accessible(MuCluster *);
+	/* stack for tagging the nodes subsumed by x */
+	std::vector<MuCluster *> vstack;
+	/* state of each node in current round */
+	std::vector<VState> visitset;
+	/* number of unvisited parents in sub-graph for each node in current round */
+	std::vector<unsigned int> counters;
+	/* round in which the state and counter of each node are set */
+	std::vector<size_t> records;
+	/* round of initial() */
+	size_t round;
+
+	/* set the state and counter of the node when it is first touched in this round */
+	void touch(MuCluster *);
 };
 /* to iterate unvisited nodes in subgraph of MSG in a random orders */
 class _MSG_VSpace_randomly : public _MSG_VSpace {
@@ -396,15 +422,33 @@ public:
 	friend class MSGLinker;
 protected:
 	/* create a visit space for sub-graph from leafs to the roots */
-	_MSG_VSpace_randomly(const std::set<MuCluster *> & as) : adset(as) {}
+	_MSG_VSpace_randomly(const MSGraph & g, const std::vector<char> & as) : 
+		graph(g), adset(as), cursor(0), round(0) {}
 	/* deconstructor */
 	~_MSG_VSpace_randomly();
 
 private:
-	/* set of nodes in sub-graph */
-	const std::set<MuCluster *> & adset;
-	/* set of nodes have not been visited */
-	std::set<MuCluster *> visitset;
+	/* graph where the nodes are defined */
+	const MSGraph & graph;
+	/* whether each node is in sub-graph */
+	const std::vector<char> & adset;
+	/* id of the next node to be checked by next() */
+	MuCluster::ID cursor;
+
+	/* stack for tagging the nodes subsuming | subsumed by x */
+	std::vector<MuCluster *> vstack;
+	/* state of each node in current round */
+	std::vector<VState> visitset;
+	/* round in which the state of each node is set */
+	std::vector<size_t> records;
+	/* round of initial() */
+	size_t round;
+
+	/* get the state of node k in this round */
+	VState & state_of(MuCluster::ID k) {
+		if (records[k] != round) { records[k] = round; visitset[k] = unvisited; }
+		return visitset[k];
+	}
 };
 /* linker for direct subsumption in MSG */
 class MSGLinker {
@@ -418,7 +462,7 @@ public:
 	friend class MSGBuilder;
 protected:
 	/* create a linker to connect MSG */
-	MSGLinker() : graph(nullptr), vspace(nullptr) {}
+	MSGLinker() : graph(nullptr), vspace(nullptr), threads(1) {}
 	/* deconstructor */
 	~MSGLinker() { close(); }
 
@@ -434,21 +478,33 @@ protected:
 	void open(MSGraph &, OrderOption);
 	/* compute the nodes directly subsumed by x in sub-graph */
 	void compute_direct_subsumption(MuCluster &, std::set<MuCluster *> &);
+	/* compute the nodes directly subsumed by x in sub-graph by the visit space, and return the comparisons */
+	size_t compute_direct_subsumption(_MSG_VSpace &, MuCluster &, std::set<MuCluster *> &);
+	/* 
+	*	compute DS for each node in the level by workers, each block of which uses its own visit space 
+	*	over the (read-only) sub-graph, and put them into solutions in the same order as sequential one.
+	*/
+	void compute_direct_subsumption(ThreadPool &, OrderOption, const std::set<MuCluster *> &, 
+		std::map<MuCluster *, std::set<MuCluster *> *> &);
 	/* connect x to the nodes in DS */
 	void connect_nodes(MuCluster &, const std::set<MuCluster *> &);
 	/* add all the nodes in sub-graph and update its leafs | roots */
 	void add_nodes_in(const std::set<MuCluster *> &);
 	/* clear the sub-graph and visit-space */
 	void close();
+	/* create a visit space of the order over the sub-graph */
+	_MSG_VSpace * new_vspace(OrderOption);
 
 private:
 	/* graph to be processed */
 	MSGraph * graph;
 	/* visit space for computing DS */
 	_MSG_VSpace * vspace;
+	/* workers to compute DS in each level (1 for sequential, 0 for the number of cores) */
+	size_t threads;
 
-	/* set of nodes in sub-graph */
-	std::set<MuCluster *> adset;
+	/* whether each node (by MuCluster::ID) is in sub-graph */
+	std::vector<char> adset;
 	/* set of leafs in sub-graph */
 	std::set<MuCluster *> leafs;
 	/* set of roots in sub-graph */
@@ -463,7 +519,7 @@ private:
 class MSGBuilder {
 public:
 	/* create a builder for MSG */
-	MSGBuilder() : graph(nullptr), trie(nullptr) {}
+	MSGBuilder() : graph(nullptr), index(nullptr), strategy(BitIndex::trie), cluster_statistics() {}
 	/* deconstructor */
 	~MSGBuilder() { close(); }
 
@@ -471,6 +527,12 @@ public:
 	void open(MSGraph &);
 	/* add mutant and its score vector to the graph */
 	void add(Mutant::ID, const BitSeq &);
+	/* 
+	*	add the mutants of subset in parent (of the same space) and link the clusters by 
+	*	the transitive reduction of parent's subsumption, so that no score vectors are
+	*	compared. The graph should be empty and is linked when returned.
+	*/
+	void induce(const MSGraph &, const MutantSet &);
 	/* create the edges between nodes without specifying its order */
 	void link();
 	/* create the edges between nodes in MSG */
@@ -478,11 +540,22 @@ public:
 	/* close the builder and clear trie and linker */
 	void close();
 
+	/* set the workers to link the clusters in each level (1 by default, 0 for the number of cores) */
+	void set_linking_threads(size_t n) { linker.threads = n; }
+	/* set the strategy to cluster mutants in next open (trie by default) */
+	void set_clustering(BitIndex::Strategy s) { strategy = s; }
+	/* get the statistics of index (of the last graph when closed) */
+	const BitIndex::Statistics & get_clustering_statistics() const;
+
 private:
 	/* graph to be built */
 	MSGraph * graph;
-	/* trie tree for clustering */
-	BitTrieTree * trie;
+	/* index for clustering */
+	BitIndex * index;
+	/* strategy to create index */
+	BitIndex::Strategy strategy;
+	/* statistics of index when builder is closed */
+	BitIndex::Statistics cluster_statistics;
 	/* to connect nodes in graph */
 	MSGLinker linker;
 };
\ No newline at end of file
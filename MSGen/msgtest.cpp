@@ -82,14 +82,14 @@ static void print_ms_graph(const MS_Graph & graph, std::ostream & out) {
 		MSG_Node & node = graph.get_node(k);
 		S += node.get_ou_port().degree();
 		if (node.get_score_degree() == 0)
-			E = node.get_mutants().number_of_mutants();
+			E = node.size();
 		else {
 			minouts += (1 + node.get_ou_port().degree())
-				* node.get_mutants().number_of_mutants();
+				* node.size();
 			maxouts += (
-				node.get_mutants().number_of_mutants() - 1
+				node.size() - 1
 				+ node.get_ou_port().degree())
-				* node.get_mutants().number_of_mutants();
+				* node.size();
 		}
 	}
 	int R = (M - E) * (M - E) - M;
@@ -109,7 +109,7 @@ static void print_ms_graph(const MS_Graph & graph, std::ostream & out) {
 	for (int i = 0; i < C; i++) {
 		MSG_Node & node = graph.get_node(i);
 		if (node.get_score_degree() > 0) {
-			Ci = node.get_mutants().number_of_mutants();
+			Ci = node.size();
 			ER += Ci * (Ci - 1) / 2;
 		}
 		else EDR = node.get_ou_port().degree();
@@ -305,7 +305,7 @@ static size_t calculate_mutants_of_nodes(const std::set<MSG_Node *> & nodes) {
 	auto end = nodes.end();
 	while (beg != end) {
 		MSG_Node & node = *(*(beg++));
-		sum += node.get_mutants().number_of_mutants();
+		sum += node.size();
 	}
 
 	return sum;
@@ -428,7 +428,7 @@ static void print_graph(const MS_Graph & graph, std::ostream & out) {
 		MSG_Node & node = graph.get_node(id);
 		if (node.get_score_degree() > 0) {
 			out << id << "\t";
-			out << node.get_mutants().number_of_mutants() << "\t";
+			out << node.size() << "\t";
 			out << node.get_score_degree() << "\t";
 			
 			calculate_nodes_subsumed_by(node, subsummeds);
@@ -487,7 +487,7 @@ static void print_block(MS_Graph & csg, MS_Graph & msg, std::ostream & out) {
 
 			/* get pairs */
 			const std::set<MSG_Pair *> & pairs = relations.get_related_targets(cnode);
-			double CN = pairs.size(), MN = cnode.get_mutants().number_of_mutants();
+			double CN = pairs.size(), MN = cnode.size();
 
 			/* calculate mutant arguments */
 			double AD = 0.0, AS = 0.0, AU = 0.0;
@@ -496,7 +496,7 @@ static void print_block(MS_Graph & csg, MS_Graph & msg, std::ostream & out) {
 			auto beg = pairs.begin(), end = pairs.end();
 			while (beg != end) {
 				MSG_Pair & pair = *(*(beg++));
-				double PN = pair.get_mutants().number_of_mutants();
+				double PN = pair.size_of();
 				MSG_Node & mnode = pair.get_target();
 				if (msg_args.count(&mnode) > 0) {
 					size_t * margs = (msg_args.find(&mnode))->second;
@@ -546,7 +546,7 @@ static void print_value(MS_Graph & msg, std::ostream & out) {
 		/* calculate the value */
 		calculate_nodes_subsumed_by(node, subsummeds);
 		value = calculate_mutants_of_nodes(subsummeds);
-		value += node.get_mutants().number_of_mutants() - 1;
+		value += node.size() - 1;
 
 		/* record the value */
 		node_value[&node] = value;
@@ -572,7 +572,7 @@ static void print_value(MS_Graph & msg, std::ostream & out) {
 		value_nodes[value] = (iter1->second) + 1;
 		auto iter2 = value_mutants.find(value);
 		value_mutants[value] = (iter2->second) 
-			+ node.get_mutants().number_of_mutants();
+			+ node.size();
 
 		beg++;
 	}
@@ -622,7 +622,7 @@ static void evaluate_csg_nodes(MS_Graph & csg, MS_Graph & msg, std::map<MSG_Node
 		if (relations.has_related_targets(cnode)) {
 			/* get pairs */
 			const std::set<MSG_Pair *> & pairs = relations.get_related_targets(cnode);
-			double CN = pairs.size(), MN = cnode.get_mutants().number_of_mutants();
+			double CN = pairs.size(), MN = cnode.size();
 
 			/* calculate mutant arguments */
 			double AD = 0.0, AS = 0.0, AU = 0.0;
@@ -631,7 +631,7 @@ static void evaluate_csg_nodes(MS_Graph & csg, MS_Graph & msg, std::map<MSG_Node
 			auto beg = pairs.begin(), end = pairs.end();
 			while (beg != end) {
 				MSG_Pair & pair = *(*(beg++));
-				double PN = pair.get_mutants().number_of_mutants();
+				double PN = pair.size_of();
 				MSG_Node & mnode = pair.get_target();
 				if (msglib.count(&mnode) > 0) {
 					size_t * margs = (msglib.find(&mnode))->second;
@@ -767,7 +767,7 @@ static void output_subsumption(MS_Graph & msg, MS_Graph & csg) {
 			auto beg1 = pairs.begin(), end = pairs.end();
 			while (beg1 != end) {
 				MSG_Pair & pair1 = *(*(beg1++));
-				size_t mutants = pair1.get_mutants().number_of_mutants();
+				size_t mutants = pair1.size_of();
 				//eq_inner = eq_inner + mutants * (mutants - 1) / 2;
 				eq_inner = eq_inner + mutants - 1;
 
@@ -811,7 +811,7 @@ static void output_subsumption(MS_Graph & msg, MS_Graph & csg) {
 				while (src_beg != src_end) {
 					MSG_Pair & src_pair = *(*(src_beg++));
 					size_t src_mutants = src_pair.
-						get_mutants().number_of_mutants();
+						size_of();
 					MSG_Node & B1 = src_pair.get_target();
 					const BitSeq & C1 = B1.get_score_vector();
 
@@ -820,7 +820,7 @@ static void output_subsumption(MS_Graph & msg, MS_Graph & csg) {
 					while (trg_beg != trg_end) {
 						MSG_Pair & trg_pair = *(*(trg_beg++));
 						size_t trg_mutants = trg_pair.
-							get_mutants().number_of_mutants();
+							size_of();
 						MSG_Node & B2 = trg_pair.get_target();
 						const BitSeq & C2 = B2.get_score_vector();
 
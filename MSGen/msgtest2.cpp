@@ -354,7 +354,7 @@ static void print_msgraph(const MS_Graph & graph, std::ostream & out) {
 		out << "shape=box,";
 		out << "label=\""; 
 		out << "<MSG-Node-" << k << ">\\n";
-		out << node.get_mutants().number_of_mutants() << "-mutants\\n";
+		out << node.size() << "-mutants\\n";
 		out << node.get_score_degree() << "-degrees\\n";
 		auto iter = utilities.find(&node);
 		out << iter->second << "-utility\\n";
@@ -443,7 +443,7 @@ static void print_graphic(const MS_Graph & graph, std::ostream & out) {
 		out << node.get_score_degree() << "\t";
 		auto iter = utilities.find(&node);
 		out << iter->second << "\t";
-		out << node.get_mutants().number_of_mutants() << "\t";
+		out << node.size() << "\t";
 
 		const MSG_Port & port = node.get_ou_port();
 		for (int i = 0; i < port.degree(); i++) {
@@ -1,7 +1,11 @@
 // include-list
 #include "sgraph.h"
 #include "cfunc.h"
+#include "bitkern.h"
+#include "domset.h"
+#include "fgraph.h"
 #include <time.h>
+#include <chrono>
 
 /* ------------------ Basic Methods ------------------------- */
 /* eliminate the spaces of '\n' */
@@ -191,13 +195,15 @@ static void load_ms_graph(
 	// get score vector producer | consumer
 	ScoreSource & score_src = cscore.get_source(cfile);
 	ScoreFunction & score_func = *(score_src.create_function(tests, mutants));
-	FileScoreProducer producer(score_func); ScoreConsumer consumer(score_func);
+	ScoreProducer & producer = *(score_src.create_producer(score_func)); 
+	ScoreConsumer consumer(score_func);
 
 	// filter for selection
 	ScoreFilter fproducer(producer, subset);
 	build_up_graph(graph, fproducer, consumer);
 
 	// release resource
+	score_src.delete_producer(&producer);
 	ctest.delete_test_set(&tests); mspace.delete_set(&mutants);
 }
 /* build up MSG from project data */
@@ -213,12 +219,18 @@ static void load_ms_graph(
 	// get score vector producer | consumer
 	ScoreSource & score_src = cscore.get_source(cfile);
 	ScoreFunction & score_func = *(score_src.create_function(tests, mutants));
-	FileScoreProducer producer(score_func); ScoreConsumer consumer(score_func);
-
-	// MS-Graph-Build
-	build_up_graph(graph, producer, consumer);
+	ScoreProducer & producer = *(score_src.create_producer(score_func)); 
+	ScoreConsumer consumer(score_func);
+
+	// MS-Graph-Build (parsing overlaps with clustering)
+	{
+		PrefetchScoreProducer prefetch(producer);
+		build_up_graph(graph, prefetch, consumer);
+		prefetch.report(std::cout);
+	}
 
 	// release resource
+	score_src.delete_producer(&producer);
 	ctest.delete_test_set(&tests); mspace.delete_set(&mutants);
 }
 /* ------------------ MSG Building ------------------------- */
@@ -374,7 +386,7 @@ static void output_graphic(const MS_Graph & graph, std::ostream & out) {
 
 		// basic information
 		out << node.get_node_id() << "\t";
-		out << node.get_mutants().number_of_mutants() << "\t";
+		out << node.size() << "\t";
 		out << node.get_score_degree() << "\t";
 		out << get_utility_of(node) << "\t";
 
@@ -388,7 +400,7 @@ static void output_graphic(const MS_Graph & graph, std::ostream & out) {
 			out << next.get_node_id() << "; ";
 
 			dnodes += 1;
-			dmutants += next.get_mutants().number_of_mutants();
+			dmutants += next.size();
 		}
 		out << "\t";
 
@@ -401,7 +413,7 @@ static void output_graphic(const MS_Graph & graph, std::ostream & out) {
 		auto beg = nodes.begin();
 		auto end = nodes.end();
 		while (beg != end) 
-			ch_num += (*(beg++))->get_mutants().number_of_mutants();
+			ch_num += (*(beg++))->size();
 		out << nodes.size() << "\t";
 		out << ch_num << "\t";
 
@@ -424,7 +436,7 @@ static void print_msg_prevalence(const MS_Graph & graph) {
 	for (int i = 0; i < n; i++) {
 		MSG_Node & node = graph.get_node(i);
 		if (node.get_score_degree() > 0) {
-			int me = node.get_mutants().number_of_mutants();
+			int me = node.size();
 			int se = node.get_ou_port().degree();
 			get_subsumed(node, children);
 
@@ -438,7 +450,7 @@ static void print_msg_prevalence(const MS_Graph & graph) {
 			while (beg != end) {
 				MSG_Node & next = *(*(beg++));
 				if (&node != &next) {
-					int mt = next.get_mutants().number_of_mutants();
+					int mt = next.size();
 					all_sc = all_sc + me * mt;
 				}
 			}	// end while
@@ -453,8 +465,223 @@ static void print_msg_prevalence(const MS_Graph & graph) {
 }
 /* ------------------ Printters ------------------------- */
 
+/* ------------------ Builder Checks ------------------------- */
+/* signature of graph: "mutants | first mutants of children" for each node, by its first mutant */
+static void signature_of(const FrozenMSG & graph, std::map<Mutant::ID, std::string> & lines) {
+	lines.clear();
+	for (FrozenMSG::ID k = 0; k < graph.size(); k++) {
+		FrozenNode node = graph.get_node(k);
+		if (node.size() == 0) continue;
+
+		std::string line; std::set<Mutant::ID> nexts;
+		for (size_t i = 0; i < node.size(); i++)
+			line += std::to_string(node.get_mutant(i)) + " ";
+		FrozenPort port = node.get_ou_port();
+		for (size_t i = 0; i < port.degree(); i++)
+			nexts.insert(port.get_node(i).get_mutant(0));
+		line += "|";
+		auto beg = nexts.begin(), end = nexts.end();
+		while (beg != end) line += " " + std::to_string(*(beg++));
+
+		lines[node.get_mutant(0)] = line;
+	}
+}
+/* seconds since start */
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+/* compare the frozen graph with the expected signature, and print the result */
+static bool check_graph(const std::string & name, const FrozenMSG & graph, 
+	const std::map<Mutant::ID, std::string> & expected, double seconds) {
+	std::map<Mutant::ID, std::string> lines; signature_of(graph, lines);
+	bool same = (lines == expected);
+	std::cout << "\t" << name << ":\t" << graph.size() << " nodes\t" << graph.number_of_edges() 
+		<< " edges\t" << seconds << " s\t" << (same ? "OK" : "MISMATCH") << "\n";
+	return same;
+}
+/* build up the graph from the rows of matrix over the function, and return the seconds */
+static double build_from_matrix(MSG_Build & builder, const ScoreMatrix & matrix, const ScoreFunction & func) {
+	MatrixScoreProducer producer(matrix, func); ScoreConsumer consumer(func);
+	auto start = std::chrono::steady_clock::now();
+	builder.open(producer, consumer); builder.build(); builder.close();
+	return seconds_since(start);
+}
+/*
+*	Rebuild the graph by the parallel builders, the incremental updates (insert | remove 
+*	mutants, induce) and the refiner (evolve, remove | add tests) from the rows of matrix,
+*	and compare them with a fresh sequential MSG_Build_Fast, where func covers all the 
+*	tests of matrix and evens covers its even tests. The evolution curve is written to 
+*	curve. Return the number of mismatches.
+*/
+static int check_builders(const ScoreMatrix & matrix, const ScoreFunction & func, 
+	const ScoreFunction & evens, std::ostream & curve) {
+	MutantSpace & mspace = matrix.get_mutant_space();
+	const BitMatrix & kills = matrix.get_matrix();
+	TestCase::ID tnum = kills.column_number();
+	int errors = 0; FrozenMSG frozen;
+
+	std::vector<Mutant::ID> loaded;
+	MutantSet & loaded_set = *(mspace.create_set());
+	for (Mutant::ID mid = 0; mid < mspace.number_of_mutants(); mid++) {
+		if (matrix.has_score_vector(mid)) {
+			loaded.push_back(mid); loaded_set.add_mutant(mid);
+		}
+	}
+
+	// reference: sequential MSG_Build_Fast
+	MS_Graph reference(mspace); std::map<Mutant::ID, std::string> expected;
+	{
+		MSG_Build_Fast builder(reference);
+		double seconds = build_from_matrix(builder, matrix, func);
+		frozen.freeze(reference); signature_of(frozen, expected);
+		std::cout << "\tMSG_Build_Fast (reference):\t" << frozen.size() << " nodes\t" 
+			<< frozen.number_of_edges() << " edges\t" << seconds << " s\n";
+	}
+	{
+		MS_Graph graph(mspace); MSG_Build_Classical builder(graph);
+		double seconds = build_from_matrix(builder, matrix, func);
+		frozen.freeze(graph); errors += !check_graph("MSG_Build_Classical", frozen, expected, seconds);
+	}
+
+	// MSG_Build_Quick by each pivoting and partitioning, sequential and on all cores
+	for (int option = 0; option < 8; option++) {
+		MSG_Build_Quick::PivotOption pivoting = (option & 1) ? 
+			MSG_Build_Quick::median_pivot : MSG_Build_Quick::first_pivot;
+		bool in_place = (option & 2) != 0; size_t threads = (option & 4) ? 0 : 1;
+
+		MS_Graph graph(mspace); MSG_Build_Quick builder(graph);
+		builder.set_pivoting(pivoting); builder.set_in_place(in_place); builder.set_parallel(threads);
+		double seconds = build_from_matrix(builder, matrix, func);
+
+		std::string name = "MSG_Build_Quick(";
+		name += (pivoting == MSG_Build_Quick::median_pivot) ? "median" : "first";
+		name += in_place ? ", in-place" : ", sets";
+		name += ", threads = " + std::to_string(threads) + ")";
+		frozen.freeze(graph); errors += !check_graph(name, frozen, expected, seconds);
+	}
+
+	// MSGBuilder linking by each order, sequential and on all cores
+	for (int option = 0; option < 6; option++) {
+		MSGLinker::OrderOption order = option % 3; size_t threads = option < 3 ? 1 : 0;
+
+		MSGraph graph(mspace); MSGBuilder builder;
+		auto start = std::chrono::steady_clock::now();
+		builder.set_linking_threads(threads); builder.open(graph);
+		for (size_t k = 0; k < loaded.size(); k++)
+			builder.add(loaded[k], BitSeq(tnum, matrix.get_kill_tests(loaded[k])));
+		builder.link(order); builder.close();
+		double seconds = seconds_since(start);
+
+		std::string name = "MSGBuilder(order = " + std::to_string((int)order) 
+			+ ", threads = " + std::to_string(threads) + ")";
+		frozen.freeze(graph); errors += !check_graph(name, frozen, expected, seconds);
+	}
+
+	// insert all mutants, then remove a third of them (as the induced graph) and insert them back
+	{
+		MS_Graph graph(mspace);
+		auto start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < loaded.size(); k++)
+			graph.insert_mutant(loaded[k], BitSeq(tnum, matrix.get_kill_tests(loaded[k])));
+		frozen.freeze(graph); 
+		errors += !check_graph("MS_Graph::insert_mutant", frozen, expected, seconds_since(start));
+
+		MutantSet & kept = *(mspace.create_set());
+		start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < loaded.size(); k++) {
+			if (k % 3 == 0) graph.remove_mutant(loaded[k]);
+			else kept.add_mutant(loaded[k]);
+		}
+		double seconds = seconds_since(start);
+
+		MS_Graph induced(mspace); induced.induce(reference, kept);
+		std::map<Mutant::ID, std::string> lines;
+		frozen.freeze(induced); signature_of(frozen, lines);
+		frozen.freeze(graph); errors += !check_graph("MS_Graph::remove_mutant (vs induce)", frozen, lines, seconds);
+
+		start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < loaded.size(); k += 3)
+			graph.insert_mutant(loaded[k], BitSeq(tnum, matrix.get_kill_tests(loaded[k])));
+		frozen.freeze(graph); 
+		errors += !check_graph("MS_Graph::insert_mutant (again)", frozen, expected, seconds_since(start));
+		mspace.delete_set(&kept);
+	}
+
+	// refine the clusters by all tests, then remove the odd tests and add them back
+	{
+		MSG_Refiner refiner(loaded_set); std::vector<TestCase::ID> order;
+		for (TestCase::ID tid = 0; tid < tnum; tid++) order.push_back(tid);
+
+		MS_Graph graph(mspace);
+		auto start = std::chrono::steady_clock::now();
+		refiner.evolve(kills, order, curve);
+		double seconds = seconds_since(start);
+		refiner.write(graph); frozen.freeze(graph); 
+		errors += !check_graph("MSG_Refiner::evolve", frozen, expected, seconds);
+
+		// expected graph over the even tests (projected out of the rows)
+		std::map<Mutant::ID, std::string> lines;
+		{
+			MS_Graph even_graph(mspace); MSG_Build_Fast builder(even_graph);
+			build_from_matrix(builder, matrix, evens);
+			frozen.freeze(even_graph); signature_of(frozen, lines);
+		}
+
+		start = std::chrono::steady_clock::now();
+		for (TestCase::ID tid = 1; tid < tnum; tid += 2) refiner.remove_test(tid);
+		seconds = seconds_since(start);
+		refiner.write(graph); frozen.freeze(graph);
+		errors += !check_graph("MSG_Refiner::remove_test", frozen, lines, seconds);
+
+		start = std::chrono::steady_clock::now();
+		for (TestCase::ID tid = 1; tid < tnum; tid += 2)
+			refiner.add_test(tid, BitSeq(kills.row_number(), kills.get_column(tid)));
+		seconds = seconds_since(start);
+		refiner.write(graph); frozen.freeze(graph);
+		errors += !check_graph("MSG_Refiner::add_test", frozen, expected, seconds);
+	}
+
+	mspace.delete_set(&loaded_set); return errors;
+}
+/* check the builders over the score vectors of code file */
+static int check_builders(const CodeFile & cfile, CMutant & cmutant, 
+	CTest & ctest, CScore & cscore, std::ostream & curve) {
+	// get set of mutants and tests (all | even ones) in project
+	MutantSpace & mspace = cmutant.get_mutants_of(cfile);
+	MutantSet & mutants = *(mspace.create_set()); mutants.complement();
+	TestSet & tests = *(ctest.malloc_test_set()); tests.complement();
+	TestSet & evens = *(ctest.malloc_test_set());
+	for (TestCase::ID tid = 0; tid < tests.size(); tid += 2) evens.add_test(tid);
+	ScoreSource & score_src = cscore.get_source(cfile);
+	ScoreFunction & score_func = *(score_src.create_function(tests, mutants));
+	ScoreFunction & even_func = *(score_src.create_function(evens, mutants));
+
+	// load the score vectors once, to be replayed from the rows of matrix
+	ScoreMatrix matrix(mspace, ctest.get_space());
+	{
+		ScoreProducer & producer = *(score_src.create_producer(score_func));
+		ScoreConsumer consumer(score_func);
+		matrix.add_score_vectors(producer, consumer);
+		score_src.delete_producer(&producer);
+	}
+
+	std::cout << "Check builders for: " << cfile.get_file().get_path() << "\n";
+	int errors = check_builders(matrix, score_func, even_func, curve);
+
+	// release resource
+	score_src.delete_function(&even_func); score_src.delete_function(&score_func);
+	ctest.delete_test_set(&evens); ctest.delete_test_set(&tests); 
+	mspace.delete_set(&mutants); return errors;
+}
+/* ------------------ Builder Checks ------------------------- */
+
 /* ------------------ Main Tester ------------------------- */
 int main(int argc, char *argv[]) {
+	// micro-benchmark mode for bit-sequence kernels
+	if (argc > 1 && std::string(argv[1]) == "--bench-kernels") {
+		BitKernel::benchmark(std::cout); return 0;
+	}
+
 	// input-arguments
 	std::string prefix = "../../../MyData/SiemensSuite/";
 	std::string prname = "schedule2";
@@ -474,6 +701,31 @@ int main(int argc, char *argv[]) {
 	// load mutants and tests
 	load_tests_mutants(ctest, cmutant);
 
+	/*
+	*	compare the parallel builders, the incremental updates and the refiner with the sequential
+	*	build of each file (the evolution curves are written into evolution.txt), as reproducible
+	*	checks that can also be run under a sanitizer build.
+	*/
+	if (argc > 1 && std::string(argv[1]) == "--check-builders") {
+		int errors = 0; std::ofstream curve(pdir + "evolution.txt");
+		const std::set<CodeFile *> & files = cmutant.get_code_space().get_code_set();
+		auto fbeg = files.begin(), fend = files.end();
+		while (fbeg != fend) errors += check_builders(*(*(fbeg++)), cmutant, ctest, cscore, curve);
+		curve.close();
+		std::cout << "Mismatches: " << errors << "\n";
+		return errors == 0 ? 0 : 1;
+	}
+
+	// convert ../score/*.txt to ../score/*.bin, which are read by the following steps
+	if (argc > 1 && std::string(argv[1]) == "--convert-scores") {
+		auto sbeg = cscore.get_sources().begin(), send = cscore.get_sources().end();
+		while (sbeg != send) {
+			const ScoreSource & source = *((sbeg++)->second);
+			bool done = source.convert_to_binary();
+			std::cout << (done ? "Converted: " : "Failed: ") << source.get_binary_path() << "\n";
+		}
+	}
+
 
 	// load MSG
 	const CodeSpace & cspace = cmutant.get_code_space();
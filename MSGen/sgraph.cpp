@@ -1,12 +1,6 @@
 #include "sgraph.h"
 #include <algorithm>
 
-MSG_Port::~MSG_Port() {
-	int n = edges.size(), k;
-	for (k = 0; k < n; k++) 
-		delete edges[k];
-	edges.clear();
-}
 MSG_Edge & MSG_Port::get_edge(int k) const {
 	if (k < 0 || k >= edges.size()) {
 		CError error(CErrorType::InvalidArguments,"MSG_Port::get_edge(k)","Invalid k: " + std::to_string(k));
@@ -15,23 +9,36 @@ MSG_Edge & MSG_Port::get_edge(int k) const {
 	else return *edges[k];
 }
 bool MSG_Port::link(MSG_Node & x, MSG_Node & y) {
-	MSG_Edge * edge = new MSG_Edge(x, y);
+	MSG_Edge * edge = new (arena.allocate(sizeof(MSG_Edge), alignof(MSG_Edge))) MSG_Edge(x, y);
 	edges.push_back(edge); return true;
 }
+bool MSG_Port::unlink(MSG_Node & x, MSG_Node & y) {
+	auto beg = edges.begin(), end = edges.end();
+	while (beg != end) {
+		MSG_Edge * edge = *beg;
+		if (&(edge->source) == &x && &(edge->target) == &y) {
+			edges.erase(beg); return true;
+		}
+		else beg++;
+	}
+	return false;
+}
 
-MSG_Node::MSG_Node(MS_Graph & g, long cid, const BitSeq & svec) : 
-	graph(g), id(cid), mutants(nullptr), score_vector(svec), in_port(), ou_port() {
-	mutants = g.get_space().create_set();
+MSG_Node::MSG_Node(MS_Graph & g, long cid, const BitSeq & svec, MemoryArena & arena) : 
+	graph(g), id(cid), mutants(g.get_space(), &arena), ou_port(arena), in_port(arena),
+	score_vector(svec.bit_number(), BitSeq::copy_words(arena, svec)) {
 	score_degree = svec.degree();
 }
-MSG_Node::~MSG_Node() {
-	graph.get_space().delete_set(mutants);
-}
 bool MSG_Node::link_to(MSG_Node & next) {
 	ou_port.link(*this, next);
 	next.in_port.link(*this, next);
 	return true;
 }
+bool MSG_Node::unlink_to(MSG_Node & next) {
+	if (ou_port.unlink(*this, next)) 
+		return next.in_port.unlink(*this, next);
+	else return false;
+}
 
 MSG_Node & MS_Graph::get_node(long id) const {
 	if (id < 0 || id >= nodes.size()) {
@@ -51,8 +58,9 @@ MSG_Node & MS_Graph::get_node_of(Mutant::ID mid) const {
 	}
 }
 MSG_Node & MS_Graph::new_node(const BitSeq & svec) {
-	MSG_Node * node = new MSG_Node(*this, nodes.size(), svec);
-	nodes.push_back(node); return *node;
+	MSG_Node * node = new (arena.allocate(sizeof(MSG_Node), alignof(MSG_Node))) 
+		MSG_Node(*this, nodes.size(), svec, arena);
+	nodes.push_back(node); revision++; return *node;
 }
 bool MS_Graph::add_mutant(MSG_Node & node, Mutant::ID mid) {
 	if (mut_node.count(mid) > 0) {
@@ -61,17 +69,255 @@ bool MS_Graph::add_mutant(MSG_Node & node, Mutant::ID mid) {
 		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
 	}
 	else {
-		node.get_mutants().add_mutant(mid);
+		node.mutants.add_mutant(mid);
 		mut_node[mid] = &node; return true;
 	}
 }
 bool MS_Graph::clear() {
+	/* nodes are released with arena, except their mutant sets */
 	int k, n = nodes.size();
 	for (k = 0; k < n; k++) 
-		delete nodes[k];
-	nodes.clear(); mut_node.clear();
+		nodes[k]->mutants.clear();
+	nodes.clear(); mut_node.clear(); revision++;
+	arena.clear(); return true;
+}
+bool MS_Graph::induce(const MS_Graph & parent, const MutantSet & subset) {
+	if (&(parent.mspace) != &mspace || &(subset.get_space()) != &mspace || &parent == this) {
+		CError error(CErrorType::InvalidArguments, "MS_Graph::induce", "Unmatched space or graph");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	clear();
+
+	/* mutants in subset for each node in parent */
+	size_t n = parent.nodes.size();
+	std::vector<std::vector<Mutant::ID>> members(n);
+	const BitSeq & svec = subset.get_set_vector();
+	const word * words = svec.get_words();
+	for (BitSeq::size_t i = 0; i < svec.word_number(); i++) {
+		word w = words[i];
+		while (w != 0) {
+			Mutant::ID mid = i * WORD_BITS + word_ctz(w); w &= w - 1;
+			if (mid >= svec.bit_number()) break;
+			auto iter = parent.mut_node.find(mid);
+			if (iter != parent.mut_node.end()) 
+				members[iter->second->id].push_back(mid);
+		}
+	}
+
+	/* create the nodes by the order of parent nodes */
+	std::vector<long> local(n, -1); std::vector<MSG_Node *> kept;
+	for (size_t k = 0; k < n; k++) {
+		if (members[k].empty()) continue;
+		MSG_Node & node = new_node(parent.nodes[k]->score_vector);
+		local[k] = node.id; kept.push_back(parent.nodes[k]);
+		for (size_t j = 0; j < members[k].size(); j++) 
+			add_mutant(node, members[k][j]);
+	}
+
+	/* nodes left that are reachable from each one without passing the others */
+	size_t m = kept.size();
+	std::vector<std::vector<unsigned int>> next(m), direct;
+	std::vector<unsigned int> stamps(n, 0), order(m);
+	std::vector<MSG_Node *> stack;
+	for (unsigned int x = 0; x < m; x++) {
+		stack.push_back(kept[x]); order[x] = x;
+		while (!stack.empty()) {
+			MSG_Node & y = *(stack.back()); stack.pop_back();
+			for (size_t k = 0; k < y.ou_port.degree(); k++) {
+				MSG_Node & z = y.ou_port.get_edge(k).get_target();
+				if (stamps[z.id] == x + 1) continue;
+				stamps[z.id] = x + 1;
+
+				if (local[z.id] >= 0) next[x].push_back(local[z.id]);
+				else stack.push_back(&z);
+			}
+		}
+	}
+
+	/* subsumed nodes (of higher degree) are reduced before their subsuming ones */
+	std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+		return nodes[a]->score_degree > nodes[b]->score_degree;
+	});
+	BitMatrix::reduce_transitive(next, order, direct);
+	for (unsigned int x = 0; x < m; x++) {
+		for (size_t k = 0; k < direct[x].size(); k++)
+			connect(*(nodes[x]), *(nodes[direct[x][k]]));
+	}
+	return true;
+}
+MSG_Node & MS_Graph::insert_mutant(Mutant::ID mid, const BitSeq & svec) {
+	if (mut_node.count(mid) > 0) {
+		CError error(CErrorType::InvalidArguments, "MS_Graph::insert_mutant", 
+			"Existing mid: " + std::to_string(mid));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	else if (!nodes.empty() && nodes[0]->score_vector.bit_number() != svec.bit_number()) {
+		CError error(CErrorType::InvalidArguments, "MS_Graph::insert_mutant", 
+			"Unmatched score vector: " + std::to_string(svec.bit_number()));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+
+	/* the node of the same vector is one of its direct subsumers */
+	std::vector<MSG_Node *> DP, DS;
+	search_subsumings(svec, DP);
+	for (size_t k = 0; k < DP.size(); k++) {
+		if (DP[k]->score_vector.equals(svec)) {
+			add_mutant(*(DP[k]), mid); return *(DP[k]);
+		}
+	}
+	search_subsumeds(svec, DS);
+
+	/* edges from its direct subsumers to its direct subsumeds are passing it now */
+	MSG_Node & node = new_node(svec); add_mutant(node, mid);
+	for (size_t i = 0; i < DP.size(); i++) {
+		for (size_t j = 0; j < DS.size(); j++)
+			DP[i]->unlink_to(*(DS[j]));
+		connect(*(DP[i]), node);
+	}
+	for (size_t j = 0; j < DS.size(); j++)
+		connect(node, *(DS[j]));
+	return node;
+}
+bool MS_Graph::remove_mutant(Mutant::ID mid) {
+	MSG_Node & node = get_node_of(mid);
+	node.mutants.del_mutant(mid); mut_node.erase(mid);
+	if (node.mutants.number_of_mutants() > 0) return false;
+
+	/* disconnect the node */
+	std::vector<MSG_Node *> prevs, nexts;
+	for (size_t k = 0; k < node.in_port.degree(); k++)
+		prevs.push_back(&(node.in_port.get_edge(k).get_source()));
+	for (size_t k = 0; k < node.ou_port.degree(); k++)
+		nexts.push_back(&(node.ou_port.get_edge(k).get_target()));
+	for (size_t i = 0; i < prevs.size(); i++) prevs[i]->unlink_to(node);
+	for (size_t j = 0; j < nexts.size(); j++) node.unlink_to(*(nexts[j]));
+
+	/* link its parents to its children not subsumed by their other children */
+	for (size_t i = 0; i < prevs.size(); i++) {
+		MSG_Node & x = *(prevs[i]); size_t n = x.ou_port.degree();
+		for (size_t j = 0; j < nexts.size(); j++) {
+			MSG_Node & y = *(nexts[j]); bool direct = true;
+			for (size_t k = 0; k < n && direct; k++) {
+				MSG_Node & z = x.ou_port.get_edge(k).get_target();
+				if (z.score_vector.subsume(y.score_vector)) direct = false;
+			}
+			if (direct) connect(x, y);
+		}
+	}
+
+	delete_node(node); return true;
+}
+void MS_Graph::delete_node(MSG_Node & node) {
+	MSG_Node * last = nodes.back();
+	nodes[node.id] = last; last->id = node.id;
+	nodes.pop_back(); node.mutants.clear(); revision++;
+}
+bool MS_Graph::available_topdown(MSG_Node & y, const std::vector<char> & VS) const {
+	for (size_t k = 0; k < y.in_port.degree(); k++) {
+		if (VS[y.in_port.get_edge(k).get_source().id]) return false;
+	}
 	return true;
 }
+bool MS_Graph::available_downtop(MSG_Node & y, const std::vector<char> & VS) const {
+	for (size_t k = 0; k < y.ou_port.degree(); k++) {
+		if (VS[y.ou_port.get_edge(k).get_target().id]) return false;
+	}
+	return true;
+}
+void MS_Graph::search_subsumeds(const BitSeq & svec, std::vector<MSG_Node *> & DS) const {
+	/* nodes of higher degree are visited when none of their parents are left */
+	BitSeq::size_t degree = svec.degree(); size_t n = nodes.size();
+	std::vector<char> VS(n, 0), records(n, 0);
+	for (size_t k = 0; k < n; k++) VS[k] = nodes[k]->score_degree > degree;
+	std::queue<MSG_Node *> queue;
+	for (size_t k = 0; k < n; k++) {
+		if (VS[k] && available_topdown(*(nodes[k]), VS)) {
+			queue.push(nodes[k]); records[k] = 1;
+		}
+	}
+
+	/* iterate */
+	DS.clear();
+	while (!queue.empty()) {
+		MSG_Node & y = *(queue.front()); queue.pop();
+		if (!VS[y.id]) continue;
+		else VS[y.id] = 0;
+
+		const MSG_Port & port = y.ou_port;
+		if (svec.subsume(y.score_vector)) {
+			/* erase children for one-level (performance) */
+			DS.push_back(&y);
+			for (size_t i = 0; i < port.degree(); i++)
+				VS[port.get_edge(i).get_target().id] = 0;
+		}
+		else {
+			for (size_t i = 0; i < port.degree(); i++) {
+				MSG_Node & next = port.get_edge(i).get_target();
+				if (!records[next.id] && VS[next.id] && available_topdown(next, VS)) {
+					records[next.id] = 1; queue.push(&next);
+				}
+			}
+		}
+	}
+
+	/* purify DS */
+	std::vector<MSG_Node *> answers;
+	for (size_t i = 0; i < DS.size(); i++) {
+		bool direct = true;
+		for (size_t j = 0; j < DS.size() && direct; j++) {
+			if (i != j && DS[j]->score_vector.subsume(DS[i]->score_vector)) direct = false;
+		}
+		if (direct) answers.push_back(DS[i]);
+	}
+	DS.swap(answers);
+}
+void MS_Graph::search_subsumings(const BitSeq & svec, std::vector<MSG_Node *> & DP) const {
+	/* nodes of lower (or equal) degree are visited when none of their children are left */
+	BitSeq::size_t degree = svec.degree(); size_t n = nodes.size();
+	std::vector<char> VS(n, 0), records(n, 0);
+	for (size_t k = 0; k < n; k++) VS[k] = nodes[k]->score_degree <= degree;
+	std::queue<MSG_Node *> queue;
+	for (size_t k = 0; k < n; k++) {
+		if (VS[k] && available_downtop(*(nodes[k]), VS)) {
+			queue.push(nodes[k]); records[k] = 1;
+		}
+	}
+
+	/* iterate */
+	DP.clear();
+	while (!queue.empty()) {
+		MSG_Node & y = *(queue.front()); queue.pop();
+		if (!VS[y.id]) continue;
+		else VS[y.id] = 0;
+
+		const MSG_Port & port = y.in_port;
+		if (y.score_vector.subsume(svec)) {
+			/* erase parents for one-level (performance) */
+			DP.push_back(&y);
+			for (size_t i = 0; i < port.degree(); i++)
+				VS[port.get_edge(i).get_source().id] = 0;
+		}
+		else {
+			for (size_t i = 0; i < port.degree(); i++) {
+				MSG_Node & prev = port.get_edge(i).get_source();
+				if (!records[prev.id] && VS[prev.id] && available_downtop(prev, VS)) {
+					records[prev.id] = 1; queue.push(&prev);
+				}
+			}
+		}
+	}
+
+	/* purify DP */
+	std::vector<MSG_Node *> answers;
+	for (size_t i = 0; i < DP.size(); i++) {
+		bool direct = true;
+		for (size_t j = 0; j < DP.size() && direct; j++) {
+			if (i != j && DP[i]->score_vector.subsume(DP[j]->score_vector)) direct = false;
+		}
+		if (direct) answers.push_back(DP[i]);
+	}
+	DP.swap(answers);
+}
 
 void MSG_Build::open(ScoreProducer & producer, ScoreConsumer & consumer) {
 	close(); graph.clear();
@@ -428,27 +674,31 @@ bool MSG_Build_Classical::construct() {
 }
 
 bool MSG_Build_Fast::clustering() {
-	BitTrieTree trie; ScoreVector * vec;
-
-	while ((vec = producer->produce()) != nullptr) {
-		Mutant::ID mid = vec->get_mutant();
-		const BitSeq & bits = vec->get_vector();
-
-		BitTrie * leaf = trie.insert_vector(bits);
-		if (leaf->get_data() == nullptr) {
-			MSG_Node & node = graph.new_node(bits);
-			leaf->set_data(&node); 
-			graph.add_mutant(node, mid);
-		}
-		else {
-			MSG_Node & node = *((MSG_Node *)(leaf->get_data()));
-			graph.add_mutant(node, mid);
+	BitIndex * index = BitIndex::create(strategy); ScoreBatch * batch;
+
+	while ((batch = producer->produce_batch()) != nullptr) {
+		for (size_t k = 0; k < batch->size(); k++) {
+			const ScoreVector & vec = batch->get_vector(k);
+			Mutant::ID mid = vec.get_mutant();
+			const BitSeq & bits = vec.get_vector();
+
+			void *& data = index->insert_vector(bits);
+			if (data == nullptr) {
+				MSG_Node & node = graph.new_node(bits);
+				data = &node; 
+				graph.add_mutant(node, mid);
+			}
+			else {
+				MSG_Node & node = *((MSG_Node *)data);
+				graph.add_mutant(node, mid);
+			}
 		}
 
-		consumer->consume(vec);
+		consumer->consume_batch(batch);
 	}
 
-	return true;
+	cluster_statistics = index->get_statistics();
+	delete index; return true;
 }
 bool MSG_Build_Fast::rankByDegree(std::vector<std::set<MSG_Node *> *> & H) {
 	std::map<unsigned int, std::set<MSG_Node *> *> hmap;
@@ -477,10 +727,11 @@ bool MSG_Build_Fast::rankByDegree(std::vector<std::set<MSG_Node *> *> & H) {
 	
 	return true;
 }
-bool MSG_Build_Fast::directSubsumed(MSG_Node & x, const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & DS) {
-	return directSubsumed_topdown(x, VS, DS);
-	//return directSubsumed_downtop(x, VS, DS);
-	//return directSubsumed_randomy(x, VS, DS);
+bool MSG_Build_Fast::directSubsumed(MSG_Node & x, std::vector<MSG_Node *> & DS) {
+	round++;	/* new visit space */
+	return directSubsumed_topdown(x, DS);
+	//return directSubsumed_downtop(x, DS);
+	//return directSubsumed_randomy(x, DS);
 }
 bool MSG_Build_Fast::construct() {
 	// step1. clustering 
@@ -491,139 +742,108 @@ bool MSG_Build_Fast::construct() {
 	rankByDegree(H);
 
 	// step3. linking from H[n] to H[1]
-	std::set<MSG_Node *> base, * DS;
-	std::map<MSG_Node *, std::set<MSG_Node *> *> ans;
+	size_t n = graph.size();
+	base.clear(); roots.clear(); leafs.clear();
+	in_base.assign(n, 0); erased.assign(n, 0); records.assign(n, 0); round = 0;
 	for (int k = H.size() - 1; k >= 0; k--) {
 		/* get H[k] */
 		std::set<MSG_Node *> & level = *(H[k]);
+		if (answers.size() < level.size()) answers.resize(level.size());
 
 		/* record DS for each node in H[k] */
+		size_t i = 0;
 		auto beg = level.begin(), end = level.end();
 		while (beg != end) {
 			/* get the nodes in DS */
 			MSG_Node & x = *(*(beg++));
-			DS = new std::set<MSG_Node *>();
-			directSubsumed(x, base, *DS); 
-			ans[&x] = DS;
+			directSubsumed(x, answers[i++]); 
 		}
 
 		/* update the nodes and edges "in" DMSG */
-		beg = level.begin(), end = level.end();
+		i = 0; beg = level.begin(), end = level.end();
 		while (beg != end) {
 			/* add nodes in the DMSG */
 			MSG_Node * x = *(beg++);
-			base.insert(x);
+			base.push_back(x); in_base[x->get_node_id()] = 1;
 
 			/* connect x to its DS nodes */
-			auto iter = ans.find(x);
-			DS = iter->second;
-			auto dbeg = DS->begin();
-			auto dend = DS->end();
-			while (dbeg != dend) {
-				MSG_Node & y = *(*(dbeg++));
-				graph.connect(*x, y);
-			}
-			delete DS; DS = nullptr;
+			std::vector<MSG_Node *> & DS = answers[i++];
+			for (size_t j = 0; j < DS.size(); j++)
+				graph.connect(*x, *(DS[j]));
 		}
+		derive_roots_leafs();
 
 		/* delete current hierarchy */ 
-		delete &level; ans.clear();
+		delete &level;
 	}
 
 	// step4. end and delete resources.
-	base.clear(); H.clear(); return true;
+	base.clear(); roots.clear(); leafs.clear(); queue.clear(); 
+	in_base.clear(); erased.clear(); records.clear(); answers.clear();
+	H.clear(); return true;
 }
 
-bool MSG_Build_Fast::derive_roots(const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & roots) {
-	roots.clear();
-	auto beg = VS.begin();
-	auto end = VS.end();
-	while (beg != end) {
-		MSG_Node & x = *(*(beg++));
-		if (x.get_in_port().degree() == 0) 
-			roots.insert(&x);
+bool MSG_Build_Fast::derive_roots_leafs() {
+	roots.clear(); leafs.clear();
+	for (size_t k = 0; k < base.size(); k++) {
+		MSG_Node & x = *(base[k]);
+		if (x.get_in_port().degree() == 0) roots.push_back(&x);
+		if (x.get_ou_port().degree() == 0) leafs.push_back(&x);
 	}
 	return true;
 }
-bool MSG_Build_Fast::derive_leafs(const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & leafs) {
-	leafs.clear();
-	auto beg = VS.begin();
-	auto end = VS.end();
-	while (beg != end) {
-		MSG_Node & x = *(*(beg++));
-		if (x.get_ou_port().degree() == 0)
-			leafs.insert(&x);
+bool MSG_Build_Fast::purify_subsumeds(std::vector<MSG_Node *> & DS) {
+	/* only nodes of lower degree can subsume, and those subsumed by removed ones are subsumed by kept ones */
+	std::sort(DS.begin(), DS.end(), [](MSG_Node * a, MSG_Node * b) {
+		return a->get_score_degree() < b->get_score_degree();
+	});
+
+	size_t m = 0;
+	for (size_t i = 0; i < DS.size(); i++) {
+		bool subsumed = false;
+		for (size_t j = 0; j < m && !subsumed; j++)
+			subsumed = subsume(*(DS[j]), *(DS[i]));
+		if (!subsumed) DS[m++] = DS[i];
 	}
-	return true;
-}
-bool MSG_Build_Fast::purify_subsumeds(std::set<MSG_Node *> & DS) {
-	std::set<MSG_Node *> trash;
-	auto beg = DS.begin(), end = DS.end();
-	while (beg != end) {
-		MSG_Node * src = *(beg++);
-		if (trash.count(src) > 0) continue;
-		else {
-			auto beg2 = DS.begin();
-			while (beg2 != end) {
-				MSG_Node * trg = *(beg2++);
-				if (src == trg) continue;
-				else if (trash.count(trg) > 0) continue;
-				else if (subsume(*src, *trg))
-					trash.insert(trg);
-			}
-		}
-	}
-
-	beg = trash.begin(), end = trash.end();
-	while (beg != end) DS.erase(*(beg++));
-	return true;
+	DS.resize(m); return true;
 }
 
-bool MSG_Build_Fast::available_topdown(MSG_Node & y, const std::set<MSG_Node *> & VS) {
+bool MSG_Build_Fast::available_topdown(MSG_Node & y) {
 	const MSG_Port & port = y.get_in_port();
 	for (int i = 0; i < port.degree(); i++) {
 		MSG_Edge & edge = port.get_edge(i);
 		MSG_Node & prev = edge.get_source();
-		if (VS.count(&prev) > 0) return false;
+		if (in_space(prev)) return false;
 	}
 	return true;
 }
-bool MSG_Build_Fast::directSubsumed_topdown(MSG_Node & x, const std::set<MSG_Node *> & base, std::set<MSG_Node *> & DS) {
-	/* get the roots in current DMSG set VS */
-	std::set<MSG_Node *> roots; 
-	derive_roots(base, roots);
-
-	/* initialize the sequence to access nodes in VS */
-	std::queue<MSG_Node *> queue;
-	std::set<MSG_Node *> records;
-	auto beg = roots.begin(), end = roots.end();
-	while (beg != end) {
-		queue.push(*(beg));
-		records.insert(*(beg++));
+bool MSG_Build_Fast::directSubsumed_topdown(MSG_Node & x, std::vector<MSG_Node *> & DS) {
+	/* initialize the sequence to access nodes from roots */
+	queue.clear(); size_t head = 0;
+	for (size_t k = 0; k < roots.size(); k++) {
+		queue.push_back(roots[k]);
+		records[roots[k]->get_node_id()] = round;
 	}
 
 	/* iterate */
 	DS.clear();
-	std::set<MSG_Node *> VS(base);
-	while (!queue.empty()) {
+	while (head < queue.size()) {
 		/* get next accessible node */
-		MSG_Node & y = *(queue.front()); 
-		queue.pop();
+		MSG_Node & y = *(queue[head++]); 
 
 		/* update the visit space */
-		if (VS.count(&y) == 0) 
+		if (!in_space(y)) 
 			continue;
-		else VS.erase(&y); 
+		else erase(y); 
 		
 		/* x > y */
 		if (subsume(x, y)) {
-			DS.insert(&y);
+			DS.push_back(&y);
 			/* erase children for one-level (performance) */
 			const MSG_Port & port = y.get_ou_port();
 			for (int i = 0; i < port.degree(); i++) {
 				MSG_Edge & edge = port.get_edge(i);
-				MSG_Node & next = edge.get_target();
-				VS.erase(&next);
+				erase(edge.get_target());
 			}
 		}
 		else {
@@ -632,11 +852,11 @@ bool MSG_Build_Fast::directSubsumed_topdown(MSG_Node & x, const std::set<MSG_Nod
 			for (int i = 0; i < port.degree(); i++) {
 				MSG_Edge & edge = port.get_edge(i);
 				MSG_Node & next = edge.get_target();
-				if (records.count(&next) == 0
-					&& VS.count(&next) > 0
-					&& available_topdown(next, VS)) {
-					records.insert(&next);
-					queue.push(&next);
+				if (records[next.get_node_id()] != round
+					&& in_space(next)
+					&& available_topdown(next)) {
+					records[next.get_node_id()] = round;
+					queue.push_back(&next);
 				}
 			}
 		}
@@ -644,54 +864,46 @@ bool MSG_Build_Fast::directSubsumed_topdown(MSG_Node & x, const std::set<MSG_Nod
 
 	/* purify DS */ return purify_subsumeds(DS);
 }
-bool MSG_Build_Fast::available_downtop(MSG_Node & y, const std::set<MSG_Node *> & VS) {
+bool MSG_Build_Fast::available_downtop(MSG_Node & y) {
 	const MSG_Port & port = y.get_ou_port();
 	for (int i = 0; i < port.degree(); i++) {
 		MSG_Edge & edge = port.get_edge(i);
 		MSG_Node & next = edge.get_target();
-		if (VS.count(&next) > 0) return false;
+		if (in_space(next)) return false;
 	}
 	return true;
 }
-bool MSG_Build_Fast::directSubsumed_downtop(MSG_Node & x, const std::set<MSG_Node *> & base, std::set<MSG_Node *> & DS) {
-	/* get the leafs in current DMSG set VS */
-	std::set<MSG_Node *> leafs;
-	derive_leafs(base, leafs);
-
-	/* initialize the sequence to access nodes in VS */
-	std::queue<MSG_Node *> queue;
-	std::set<MSG_Node *> records;
-	auto beg = leafs.begin(), end = leafs.end();
-	while (beg != end) {
-		queue.push(*(beg));
-		records.insert(*(beg++));
+bool MSG_Build_Fast::directSubsumed_downtop(MSG_Node & x, std::vector<MSG_Node *> & DS) {
+	/* initialize the sequence to access nodes from leafs */
+	queue.clear(); size_t head = 0;
+	for (size_t k = 0; k < leafs.size(); k++) {
+		queue.push_back(leafs[k]);
+		records[leafs[k]->get_node_id()] = round;
 	}
 
 	/* iterate */
 	DS.clear();
-	std::set<MSG_Node *> VS(base);
-	while (!queue.empty()) {
+	while (head < queue.size()) {
 		/* get next accessible node */
-		MSG_Node & y = *(queue.front());
-		queue.pop();
+		MSG_Node & y = *(queue[head++]);
 
 		/* update the visit space */
-		if (VS.count(&y) == 0) continue;
-		else VS.erase(&y);
+		if (!in_space(y)) continue;
+		else erase(y);
 
 		/* x > y */
 		if (subsume(x, y)) {
-			DS.insert(&y);
+			DS.push_back(&y);
 			/* push children */
 			const MSG_Port & port = y.get_in_port();
 			for (int i = 0; i < port.degree(); i++) {
 				MSG_Edge & edge = port.get_edge(i);
 				MSG_Node & prev = edge.get_source();
-				if (records.count(&prev) == 0
-					&& VS.count(&prev) > 0
-					&& available_downtop(prev, VS)) {
-					records.insert(&prev);
-					queue.push(&prev);
+				if (records[prev.get_node_id()] != round
+					&& in_space(prev)
+					&& available_downtop(prev)) {
+					records[prev.get_node_id()] = round;
+					queue.push_back(&prev);
 				}
 			}
 		}
@@ -699,71 +911,65 @@ bool MSG_Build_Fast::directSubsumed_downtop(MSG_Node & x, const std::set<MSG_Nod
 			const MSG_Port & port = y.get_in_port();
 			for (int i = 0; i < port.degree(); i++) {
 				MSG_Edge & edge = port.get_edge(i);
-				MSG_Node & prev = edge.get_source();
-				VS.erase(&prev);
+				erase(edge.get_source());
 			}
 		}
 	}
 
 	/* purify DS */ return purify_subsumeds(DS);
 }
-bool MSG_Build_Fast::erase_subsuming(MSG_Node & y, std::set<MSG_Node *> & VS) {
-	std::queue<MSG_Node *> queue; 
-	std::set<MSG_Node *> records;
-	queue.push(&y); records.insert(&y);
+bool MSG_Build_Fast::erase_subsuming(MSG_Node & y) {
+	/* nodes erased before have had their ancestors erased (or can not reach y) */
+	queue.clear(); size_t head = 0;
+	queue.push_back(&y);
 
-	while (!queue.empty()) {
-		MSG_Node & next = *(queue.front());
-		queue.pop(); VS.erase(&next);
+	while (head < queue.size()) {
+		MSG_Node & next = *(queue[head++]);
 
-		const MSG_Port & port = y.get_in_port();
+		const MSG_Port & port = next.get_in_port();
 		for (int i = 0; i < port.degree(); i++) {
 			MSG_Edge & edge = port.get_edge(i);
 			MSG_Node & prev = edge.get_source();
-			if (records.count(&prev) == 0
-				&& VS.count(&prev) > 0) {
-				queue.push(&prev);
-				records.insert(&prev);
+			if (in_space(prev)) {
+				erase(prev); queue.push_back(&prev);
 			}
 		}
 	}
 
 	return true;
 }
-bool MSG_Build_Fast::erase_subsumeds(MSG_Node & y, std::set<MSG_Node *> & VS) {
-	std::queue<MSG_Node *> queue;
-	queue.push(&y); 
+bool MSG_Build_Fast::erase_subsumeds(MSG_Node & y) {
+	/* nodes erased before have had their descendants erased (or can not reach y) */
+	queue.clear(); size_t head = 0;
+	queue.push_back(&y); 
 
-	while (!queue.empty()) {
-		MSG_Node & next = *(queue.front());
-		queue.pop(); 
+	while (head < queue.size()) {
+		MSG_Node & next = *(queue[head++]);
 
-		const MSG_Port & port = y.get_ou_port();
+		const MSG_Port & port = next.get_ou_port();
 		for (int i = 0; i < port.degree(); i++) {
 			MSG_Edge & edge = port.get_edge(i);
-			MSG_Node & next = edge.get_target();
-			if (VS.count(&next) > 0) {
-				queue.push(&next);
-				VS.erase(&next);
+			MSG_Node & child = edge.get_target();
+			if (in_space(child)) {
+				erase(child); queue.push_back(&child);
 			}
 		}
 	}
 
 	return true;
 }
-bool MSG_Build_Fast::directSubsumed_randomy(MSG_Node & x, const std::set<MSG_Node *> & base, std::set<MSG_Node *> & DS) {
-	std::set<MSG_Node *> VS(base);
-
+bool MSG_Build_Fast::directSubsumed_randomy(MSG_Node & x, std::vector<MSG_Node *> & DS) {
 	DS.clear();
-	while (!VS.empty()) {
-		MSG_Node & y = *(*(VS.begin()));
-		VS.erase(&y);
+	for (size_t k = 0; k < base.size(); k++) {
+		MSG_Node & y = *(base[k]);
+		if (!in_space(y)) continue;
+		else erase(y);
 
 		if (subsume(x, y)) {
-			DS.insert(&y);
-			erase_subsumeds(y, VS);
+			DS.push_back(&y);
+			erase_subsumeds(y);
 		}
-		else erase_subsuming(y, VS);
+		else erase_subsuming(y);
 	}
 
 	/* purify DS */ return purify_subsumeds(DS);
@@ -774,32 +980,43 @@ bool MSG_Build_Quick::construct() {
 	return linking();
 }
 bool MSG_Build_Quick::clustering() {
-	BitTrieTree trie; ScoreVector * vec;
+	BitIndex * index = BitIndex::create(strategy); ScoreBatch * batch;
 
 	clusters.clear();
-	while ((vec = producer->produce()) != nullptr) {
-		Mutant::ID mid = vec->get_mutant();
-		const BitSeq & bits = vec->get_vector();
-
-		BitTrie * leaf = trie.insert_vector(bits);
-		if (leaf->get_data() == nullptr) {
-			MSG_Node & node = graph.new_node(bits);
-			leaf->set_data(&node);
-			graph.add_mutant(node, mid);
-			clusters.insert(&node);
-		}
-		else {
-			MSG_Node & node = *((MSG_Node *)(leaf->get_data()));
-			graph.add_mutant(node, mid);
+	while ((batch = producer->produce_batch()) != nullptr) {
+		for (size_t k = 0; k < batch->size(); k++) {
+			const ScoreVector & vec = batch->get_vector(k);
+			Mutant::ID mid = vec.get_mutant();
+			const BitSeq & bits = vec.get_vector();
+
+			void *& data = index->insert_vector(bits);
+			if (data == nullptr) {
+				MSG_Node & node = graph.new_node(bits);
+				data = &node;
+				graph.add_mutant(node, mid);
+				clusters.insert(&node);
+			}
+			else {
+				MSG_Node & node = *((MSG_Node *)data);
+				graph.add_mutant(node, mid);
+			}
 		}
 
-		consumer->consume(vec);
+		consumer->consume_batch(batch);
 	}
 
-	return true;
+	cluster_statistics = index->get_statistics();
+	delete index; return true;
 }
 bool MSG_Build_Quick::linking() {
-	this->build_up(clusters);
+	if (threads != 1) pool = new ForkJoinPool(threads);
+	if (in_place) {
+		array.assign(clusters.begin(), clusters.end());
+		this->build_up(0, array.size()); array.clear();
+	}
+	else this->build_up(clusters);
+
+	if (pool != nullptr) { delete pool; pool = nullptr; }
 	clusters.clear(); return true;
 }
 bool MSG_Build_Quick::build_up(const std::set<MSG_Node *> & nodes) {
@@ -807,78 +1024,135 @@ bool MSG_Build_Quick::build_up(const std::set<MSG_Node *> & nodes) {
 	else {
 		/* classify nodes for x */
 		std::set<MSG_Node *> S, D, N;
-		MSG_Node & x = *(*(nodes.begin()));
+		MSG_Node & x = select_pivot(nodes);
 		this->classify(nodes, x, S, D, N);
 
-		/* recursively build up sub-graph */
-		build_up(S); build_up(D); build_up(N);
+		/* recursively build up sub-graph (on disjoint nodes) */
+		std::vector<std::function<void()>> tasks;
+		tasks.push_back([this, &S] { build_up(S); });
+		tasks.push_back([this, &D] { build_up(D); });
+		tasks.push_back([this, &N] { build_up(N); });
+		invoke(tasks, nodes.size());
 
 		/* get the roots and leafs for S, D, N */
-		std::set<MSG_Node *> sleafs, sroots;
-		std::set<MSG_Node *> dleafs, droots;
-		std::set<MSG_Node *> nleafs, nroots;
+		std::vector<MSG_Node *> sleafs, sroots;
+		std::vector<MSG_Node *> dleafs, droots;
+		std::vector<MSG_Node *> nleafs, nroots;
 		derive_roots_leafs(S, sroots, sleafs);
 		derive_roots_leafs(D, droots, dleafs);
 		derive_roots_leafs(N, nroots, nleafs);
 
-		/* compute direct subsumption */
-		std::map<MSG_Node *, std::set<MSG_Node *> *> SN;
-		std::map<MSG_Node *, std::set<MSG_Node *> *> ND;
-		combine_LR(sleafs, nroots, SN);
-		combine_LR(nleafs, droots, ND);
-
-		/* build up direct subsumption */
-		// STEP 1. sleafs --> x
-		auto sleafs_beg = sleafs.begin();
-		auto sleafs_end = sleafs.end();
-		while (sleafs_beg != sleafs_end) {
-			MSG_Node & src = *(*(sleafs_beg++));
-			graph.connect(src, x);
-		}
-		// STEP 2. x --> droots
-		auto droots_beg = droots.begin();
-		auto droots_end = droots.end();
-		while (droots_beg != droots_end) {
-			MSG_Node & trg = *(*(droots_beg++));
-			graph.connect(x, trg);
-		}
-		// STEP 3. S --> N
-		auto SN_beg = SN.begin();
-		auto SN_end = SN.end();
-		while (SN_beg != SN_end) {
-			MSG_Node & src = *(SN_beg->first);
-			std::set<MSG_Node *> & nexts = *(SN_beg->second);
-
-			auto nexts_beg = nexts.begin();
-			auto nexts_end = nexts.end();
-			while (nexts_beg != nexts_end) {
-				MSG_Node & trg = *(*(nexts_beg++));
-				graph.connect(src, trg);
-			}
+		/* compute and build up direct subsumption */
+		return combine(x, nodes.size(), sleafs, droots, nroots, nleafs);
+	}
+}
+bool MSG_Build_Quick::build_up(size_t beg, size_t end) {
+	if (beg >= end) return true;		/* do nothing */
+	else {
+		/* partition nodes for x at beg */
+		size_t dbeg, nbeg;
+		partition(beg, end, dbeg, nbeg);
+		MSG_Node & x = *(array[beg]);
+
+		/* recursively build up sub-graph (on disjoint ranges) */
+		std::vector<std::function<void()>> tasks;
+		tasks.push_back([this, beg, dbeg] { build_up(beg + 1, dbeg); });
+		tasks.push_back([this, dbeg, nbeg] { build_up(dbeg, nbeg); });
+		tasks.push_back([this, nbeg, end] { build_up(nbeg, end); });
+		invoke(tasks, end - beg);
 
-			SN_beg++; delete &nexts;
+		/* get the roots and leafs for S, D, N */
+		std::vector<MSG_Node *> sleafs, sroots;
+		std::vector<MSG_Node *> dleafs, droots;
+		std::vector<MSG_Node *> nleafs, nroots;
+		derive_roots_leafs(beg + 1, dbeg, sroots, sleafs);
+		derive_roots_leafs(dbeg, nbeg, droots, dleafs);
+		derive_roots_leafs(nbeg, end, nroots, nleafs);
+
+		/* compute and build up direct subsumption */
+		return combine(x, end - beg, sleafs, droots, nroots, nleafs);
+	}
+}
+bool MSG_Build_Quick::combine(MSG_Node & x, size_t size,
+	const std::vector<MSG_Node *> & sleafs, const std::vector<MSG_Node *> & droots,
+	const std::vector<MSG_Node *> & nroots, const std::vector<MSG_Node *> & nleafs) {
+	/* compute direct subsumption (only reading the sub-graphs) */
+	std::map<MSG_Node *, std::set<MSG_Node *> *> SN;
+	std::map<MSG_Node *, std::set<MSG_Node *> *> ND;
+	std::vector<std::function<void()>> tasks;
+	tasks.push_back([this, &sleafs, &nroots, &SN] { combine_LR(sleafs, nroots, SN); });
+	tasks.push_back([this, &nleafs, &droots, &ND] { combine_LR(nleafs, droots, ND); });
+	invoke(tasks, size);
+
+	/* build up direct subsumption */
+	std::unique_lock<std::mutex> guard(connecting);
+	// STEP 1. sleafs --> x
+	auto sleafs_beg = sleafs.begin();
+	auto sleafs_end = sleafs.end();
+	while (sleafs_beg != sleafs_end) {
+		MSG_Node & src = *(*(sleafs_beg++));
+		graph.connect(src, x);
+	}
+	// STEP 2. x --> droots
+	auto droots_beg = droots.begin();
+	auto droots_end = droots.end();
+	while (droots_beg != droots_end) {
+		MSG_Node & trg = *(*(droots_beg++));
+		graph.connect(x, trg);
+	}
+	// STEP 3. S --> N
+	auto SN_beg = SN.begin();
+	auto SN_end = SN.end();
+	while (SN_beg != SN_end) {
+		MSG_Node & src = *(SN_beg->first);
+		std::set<MSG_Node *> & nexts = *(SN_beg->second);
+
+		auto nexts_beg = nexts.begin();
+		auto nexts_end = nexts.end();
+		while (nexts_beg != nexts_end) {
+			MSG_Node & trg = *(*(nexts_beg++));
+			graph.connect(src, trg);
 		}
-		// STEP 4. N --> D
-		auto ND_beg = ND.begin();
-		auto ND_end = ND.end();
-		while (ND_beg != ND_end) {
-			MSG_Node & src = *(ND_beg->first);
-			std::set<MSG_Node *> & nexts = *(ND_beg->second);
-
-			auto nexts_beg = nexts.begin();
-			auto nexts_end = nexts.end();
-			while (nexts_beg != nexts_end) {
-				MSG_Node & trg = *(*(nexts_beg++));
-				graph.connect(src, trg);
-			}
 
-			ND_beg++; delete &nexts;
+		SN_beg++; delete &nexts;
+	}
+	// STEP 4. N --> D
+	auto ND_beg = ND.begin();
+	auto ND_end = ND.end();
+	while (ND_beg != ND_end) {
+		MSG_Node & src = *(ND_beg->first);
+		std::set<MSG_Node *> & nexts = *(ND_beg->second);
+
+		auto nexts_beg = nexts.begin();
+		auto nexts_end = nexts.end();
+		while (nexts_beg != nexts_end) {
+			MSG_Node & trg = *(*(nexts_beg++));
+			graph.connect(src, trg);
 		}
 
-		/* end */ return true;
+		ND_beg++; delete &nexts;
+	}
+
+	/* end */ return true;
+}
+void MSG_Build_Quick::invoke(std::vector<std::function<void()>> & tasks, size_t size) {
+	if (pool != nullptr && size > cutoff) pool->invoke(tasks);
+	else {
+		for (size_t k = 0; k < tasks.size(); k++) tasks[k]();
 	}
 }
 
+MSG_Node & MSG_Build_Quick::select_pivot(const std::set<MSG_Node *> & nodes) {
+	if (pivoting == median_pivot) {
+		std::vector<MSG_Node *> list(nodes.begin(), nodes.end());
+		auto mid = list.begin() + list.size() / 2;
+		std::nth_element(list.begin(), mid, list.end(), [](MSG_Node * a, MSG_Node * b) {
+			return a->get_score_degree() < b->get_score_degree();
+		});
+		return *(*mid);
+	}
+	else return *(*(nodes.begin()));
+}
 bool MSG_Build_Quick::classify(const std::set<MSG_Node *> & C,
 	MSG_Node & I, std::set<MSG_Node *> & S,
 	std::set<MSG_Node *> & D, std::set<MSG_Node *> & N) {
@@ -895,22 +1169,54 @@ bool MSG_Build_Quick::classify(const std::set<MSG_Node *> & C,
 
 	return true;
 }
+void MSG_Build_Quick::partition(size_t beg, size_t end, size_t & dbeg, size_t & nbeg) {
+	/* move the pivot to beg */
+	if (pivoting == median_pivot) {
+		auto mid = array.begin() + (beg + end) / 2;
+		std::nth_element(array.begin() + beg, mid, array.begin() + end, [](MSG_Node * a, MSG_Node * b) {
+			return a->get_score_degree() < b->get_score_degree();
+		});
+		std::swap(array[beg], *mid);
+	}
+	MSG_Node & I = *(array[beg]);
+
+	/* S grows from the front and N from the back, each node classified once */
+	size_t k = beg + 1; dbeg = beg + 1; nbeg = end;
+	while (k < nbeg) {
+		MSG_Node & x = *(array[k]);
+		if (subsume(I, x)) k++;
+		else if (subsume(x, I)) std::swap(array[dbeg++], array[k++]);
+		else std::swap(array[k], array[--nbeg]);
+	}
+}
 bool MSG_Build_Quick::derive_roots_leafs(const std::set<MSG_Node *> & nodes,
-	std::set<MSG_Node *> & roots, std::set<MSG_Node *> & leafs) {
+	std::vector<MSG_Node *> & roots, std::vector<MSG_Node *> & leafs) {
 	roots.clear(); leafs.clear();
 
 	auto beg = nodes.begin();
 	auto end = nodes.end();
 	while (beg != end) {
 		MSG_Node & x = *(*(beg++));
-		if (x.get_in_port().degree() == 0) roots.insert(&x);
-		if (x.get_ou_port().degree() == 0) leafs.insert(&x);
+		if (x.get_in_port().degree() == 0) roots.push_back(&x);
+		if (x.get_ou_port().degree() == 0) leafs.push_back(&x);
+	}
+
+	return true;
+}
+bool MSG_Build_Quick::derive_roots_leafs(size_t beg, size_t end,
+	std::vector<MSG_Node *> & roots, std::vector<MSG_Node *> & leafs) {
+	roots.clear(); leafs.clear();
+
+	for (size_t k = beg; k < end; k++) {
+		MSG_Node & x = *(array[k]);
+		if (x.get_in_port().degree() == 0) roots.push_back(&x);
+		if (x.get_ou_port().degree() == 0) leafs.push_back(&x);
 	}
 
 	return true;
 }
-bool MSG_Build_Quick::combine_LR(const std::set<MSG_Node *> & aleafs,
-	const std::set<MSG_Node *> & broots,
+bool MSG_Build_Quick::combine_LR(const std::vector<MSG_Node *> & aleafs,
+	const std::vector<MSG_Node *> & broots,
 	std::map<MSG_Node *, std::set<MSG_Node *> *> & ans) {
 	/* initialization */
 	std::queue<MSG_Node *> squeue;
@@ -961,7 +1267,7 @@ bool MSG_Build_Quick::topdown_ready(MSG_Node & next, const std::set<MSG_Node *>
 	return true;
 }
 bool MSG_Build_Quick::derive_direct_subsumed(MSG_Node & source,
-	const std::set<MSG_Node *> &troots, std::set<MSG_Node *> & DS) {
+	const std::vector<MSG_Node *> &troots, std::set<MSG_Node *> & DS) {
 	/* initialization */
 	std::queue<MSG_Node *> tqueue;
 	std::set<MSG_Node *> tvisits, records;
@@ -1045,6 +1351,252 @@ bool MSG_Build_Quick::purify_direct_subsumed(std::set<MSG_Node *> & DS) {
 	return true;
 }
 
+MSG_Refiner::MSG_Refiner(const MutantSet & mutants) 
+	: mspace(mutants.get_space()), tests(), width(WORD_BITS), clusters(), edges(0) {
+	Cluster * cluster = new Cluster(width);
+	const BitSeq & svec = mutants.get_set_vector();
+	const word * words = svec.get_words();
+	for (BitSeq::size_t i = 0; i < svec.word_number(); i++) {
+		word w = words[i];
+		while (w != 0) {
+			Mutant::ID mid = i * WORD_BITS + word_ctz(w); w &= w - 1;
+			if (mid >= svec.bit_number()) break;
+			cluster->mutants.push_back(mid);
+		}
+	}
+
+	if (cluster->mutants.empty()) delete cluster;
+	else clusters.push_back(cluster);
+}
+MSG_Refiner::MSG_Refiner(const MS_Graph & graph, const std::vector<TestCase::ID> & applied)
+	: mspace(graph.get_space()), tests(applied), width(WORD_BITS), clusters(), edges(0) {
+	while (width < tests.size()) width = width * 2;
+
+	/* each node is a cluster and its direct subsumption edges are kept */
+	size_t n = graph.size();
+	for (size_t i = 0; i < n; i++) {
+		MSG_Node & node = graph.get_node(i);
+		const BitSeq & vector = node.get_score_vector();
+		if (vector.bit_number() != tests.size()) {
+			CError error(CErrorType::InvalidArguments, "MSG_Refiner::MSG_Refiner", 
+				"Unmatched tests: " + std::to_string(vector.bit_number()));
+			CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+		}
+
+		Cluster * cluster = new Cluster(width);
+		cluster->vector.assign(vector);
+		cluster->degree = node.get_score_degree();
+		const MutantList::IDs & mutants = node.get_mutant_list().get_mutant_ids();
+		cluster->mutants.assign(mutants.begin(), mutants.end());
+
+		const MSG_Port & port = node.get_ou_port();
+		for (size_t k = 0; k < port.degree(); k++)
+			cluster->nexts.push_back((unsigned int)port.get_edge(k).get_target().get_node_id());
+		edges += cluster->nexts.size();
+		clusters.push_back(cluster);
+	}
+}
+void MSG_Refiner::clear() {
+	for (size_t k = 0; k < clusters.size(); k++)
+		delete clusters[k];
+	clusters.clear(); tests.clear(); edges = 0;
+}
+void MSG_Refiner::add_test(TestCase::ID tid, const BitSeq & column) {
+	refine(tid, column.get_words(), column.bit_number());
+}
+void MSG_Refiner::refine(TestCase::ID tid, const word * column, size_t bits) {
+	if (std::find(tests.begin(), tests.end(), tid) != tests.end()) {
+		CError error(CErrorType::InvalidArguments, "MSG_Refiner::refine", 
+			"Test has been applied: " + std::to_string(tid));
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+
+	/* reserve the bit of the test in score vectors */
+	BitSeq::size_t k = tests.size(); tests.push_back(tid);
+	if (k >= width) {
+		width = width * 2;
+		for (size_t i = 0; i < clusters.size(); i++) {
+			BitSeq vector(width); vector.assign(clusters[i]->vector);
+			clusters[i]->vector = std::move(vector);
+		}
+	}
+
+	/* split each cluster into the surviving (part0) and killed (part1) ones */
+	size_t n = clusters.size();
+	std::vector<long> part0(n, -1), part1(n, -1);
+	std::vector<Mutant::ID> killed, alive;
+	for (size_t i = 0; i < n; i++) {
+		Cluster & cluster = *(clusters[i]);
+		killed.clear(); alive.clear();
+		for (size_t j = 0; j < cluster.mutants.size(); j++) {
+			Mutant::ID mid = cluster.mutants[j];
+			if (mid < bits && ((column[mid / WORD_BITS] >> (mid % WORD_BITS)) & 1))
+				killed.push_back(mid);
+			else alive.push_back(mid);
+		}
+
+		if (alive.empty()) {
+			cluster.vector.set_bit(k, BIT_1);
+			cluster.degree++; part1[i] = i;
+		}
+		else if (killed.empty()) part0[i] = i;
+		else {
+			Cluster * part = new Cluster(width);
+			part->vector.assign(cluster.vector); part->vector.set_bit(k, BIT_1);
+			part->degree = cluster.degree + 1; part->mutants.swap(killed);
+			cluster.mutants.swap(alive);
+			part0[i] = i; part1[i] = clusters.size(); clusters.push_back(part);
+		}
+	}
+
+	/*
+	*	repair the edges from old ones: a part subsumes the same part of each old
+	*	successor, and (the surviving one also subsumes its killed part or the killed
+	*	successors if not split) searches below those successors without such part 
+	*	for the nearest ones having it, of which the subsumed ones are removed.
+	*/
+	std::vector<std::vector<unsigned int>> olds(n);
+	for (size_t i = 0; i < n; i++) olds[i].swap(clusters[i]->nexts);
+	std::vector<size_t> stamps(n, 0); std::vector<unsigned int> stack, direct;
+	edges = 0;
+	for (size_t i = 0; i < n; i++) {
+		for (size_t p = 0; p < 2; p++) {
+			const std::vector<long> & same = (p == 0) ? part0 : part1;
+			if (same[i] < 0) continue;
+			std::vector<unsigned int> & nexts = clusters[same[i]]->nexts;
+
+			if (p == 0 && part1[i] >= 0) nexts.push_back(part1[i]);
+			for (size_t j = 0; j < olds[i].size(); j++) {
+				unsigned int y = olds[i][j];
+				if (same[y] >= 0) nexts.push_back(same[y]);
+				else {
+					if (p == 0 && part1[i] < 0) nexts.push_back(part1[y]);
+					stack.push_back(y);
+				}
+			}
+
+			if (!stack.empty()) {
+				size_t stamp = 2 * i + p + 1, frontier = nexts.size();
+				while (!stack.empty()) {
+					unsigned int y = stack.back(); stack.pop_back();
+					for (size_t j = 0; j < olds[y].size(); j++) {
+						unsigned int z = olds[y][j];
+						if (stamps[z] == stamp) continue;
+						stamps[z] = stamp;
+
+						if (same[z] >= 0) nexts.push_back(same[z]);
+						else stack.push_back(z);
+					}
+				}
+
+				/* remove the frontier ones subsumed by another (the others are direct) */
+				direct.assign(nexts.begin(), nexts.begin() + frontier);
+				for (size_t j = frontier; j < nexts.size(); j++) {
+					const BitSeq & vector = clusters[nexts[j]]->vector; bool reduced = false;
+					for (size_t l = 0; l < nexts.size() && !reduced; l++) {
+						if (l != j && clusters[nexts[l]]->vector.subsume(vector)) reduced = true;
+					}
+					if (!reduced) direct.push_back(nexts[j]);
+				}
+				nexts.swap(direct);
+			}
+			edges += nexts.size();
+		}
+	}
+}
+bool MSG_Refiner::remove_test(TestCase::ID tid) {
+	auto iter = std::find(tests.begin(), tests.end(), tid);
+	if (iter == tests.end()) return false;
+	BitSeq::size_t k = iter - tests.begin(), last = tests.size() - 1;
+	tests.erase(iter);
+
+	/* remove the bit of the test and merge the clusters of the same vector */
+	BitIndex * index = BitIndex::create(BitIndex::hash);
+	std::vector<Cluster *> merged;
+	for (size_t i = 0; i < clusters.size(); i++) {
+		Cluster * cluster = clusters[i]; BitSeq & vector = cluster->vector;
+		if (vector.get_bit(k) == BIT_1) cluster->degree--;
+		for (BitSeq::size_t j = k; j < last; j++)
+			vector.set_bit(j, vector.get_bit(j + 1));
+		vector.set_bit(last, BIT_0);
+		cluster->nexts.clear();
+
+		void *& slot = index->insert_vector(vector);
+		if (slot == nullptr) {
+			slot = cluster; merged.push_back(cluster);
+		}
+		else {
+			Cluster * target = (Cluster *)slot;
+			target->mutants.insert(target->mutants.end(), 
+				cluster->mutants.begin(), cluster->mutants.end());
+			delete cluster;
+		}
+	}
+	delete index; clusters.swap(merged);
+
+	relink(); return true;
+}
+void MSG_Refiner::relink() {
+	size_t n = clusters.size();
+	std::vector<std::vector<unsigned int>> next(n), direct;
+	std::vector<unsigned int> order(n);
+	for (unsigned int x = 0; x < n; x++) {
+		order[x] = x;
+		for (unsigned int y = 0; y < n; y++) {
+			if (clusters[x]->degree < clusters[y]->degree 
+				&& clusters[x]->vector.subsume(clusters[y]->vector))
+				next[x].push_back(y);
+		}
+	}
+
+	/* subsumed clusters (of higher degree) are reduced before their subsuming ones */
+	std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+		return clusters[a]->degree > clusters[b]->degree;
+	});
+	BitMatrix::reduce_transitive(next, order, direct);
+	edges = 0;
+	for (unsigned int x = 0; x < n; x++) {
+		clusters[x]->nexts.swap(direct[x]);
+		edges += clusters[x]->nexts.size();
+	}
+}
+void MSG_Refiner::write(MS_Graph & graph) const {
+	if (&(graph.get_space()) != &mspace) {
+		CError error(CErrorType::InvalidArguments, "MSG_Refiner::write", "Unmatched space");
+		CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+	}
+	graph.clear();
+
+	for (size_t i = 0; i < clusters.size(); i++) {
+		BitSeq vector(tests.size()); vector.assign(clusters[i]->vector);
+		MSG_Node & node = graph.new_node(vector);
+		const std::vector<Mutant::ID> & mutants = clusters[i]->mutants;
+		for (size_t j = 0; j < mutants.size(); j++)
+			graph.add_mutant(node, mutants[j]);
+	}
+	for (size_t i = 0; i < clusters.size(); i++) {
+		const std::vector<unsigned int> & nexts = clusters[i]->nexts;
+		for (size_t j = 0; j < nexts.size(); j++)
+			graph.connect(graph.get_node(i), graph.get_node(nexts[j]));
+	}
+}
+void MSG_Refiner::evolve(const BitMatrix & kills, 
+	const std::vector<TestCase::ID> & order, std::ostream & out) {
+	out << "tests\tclusters\tedges\n";
+	for (size_t k = 0; k < order.size(); k++) {
+		TestCase::ID tid = order[k];
+		if (tid >= kills.column_number()) {
+			CError error(CErrorType::InvalidArguments, "MSG_Refiner::evolve", 
+				"Undefined test: " + std::to_string(tid));
+			CErrorConsumer::consume(error); exit(CErrorType::InvalidArguments);
+		}
+
+		refine(tid, kills.get_column(tid), kills.row_number());
+		out << tests.size() << "\t" << clusters.size() << "\t" << edges << "\n";
+	}
+	out << std::flush;
+}
+
 const std::set<MSG_Pair *> & MSG_Relation::get_related_sources(MSG_Node & node) const {
 	if (trg_src.count(node.get_node_id()) == 0) {
 		CError error(CErrorType::InvalidArguments, 
@@ -1161,19 +1713,30 @@ void MSG_Tester::gen_tests(const std::set<Mutant::ID>
 	// generate tests
 	gen_tests(nodes, tests);
 }
+const BitMatrix & MSG_Tester::get_kill_matrix() {
+	if (kills != nullptr && revision != graph->get_revision()) {
+		delete kills; kills = nullptr;
+	}
+	if (kills == nullptr) {
+		long k, n = graph->size(); size_t tests = 0;
+		revision = graph->get_revision();
+		if (n > 0) tests = graph->get_node(0).get_score_vector().bit_number();
+
+		kills = new BitMatrix(n, tests);
+		for (k = 0; k < n; k++)
+			kills->set_row(k, graph->get_node(k).get_score_vector());
+		kills->transpose();
+	}
+	return *kills;
+}
 void MSG_Tester::eliminate(TestCase::ID tid, std::set<MSG_Node *> & nodes) {
-	std::set<MSG_Node *> removed;
-	auto beg = nodes.begin();
-	auto end = nodes.end();
+	/* only the nodes killed by tid are visited */
+	const std::vector<unsigned int> & killeds = get_kill_matrix().get_posting(tid);
+	auto beg = killeds.begin(), end = killeds.end();
 	while (beg != end) {
-		MSG_Node * node = *(beg++);
-		const BitSeq & bits = node->get_score_vector();
-		if (bits.get_bit(tid) == BIT_1) 
-			removed.insert(node);
+		MSG_Node & node = graph->get_node(*(beg++));
+		nodes.erase(&node);
 	}
-
-	beg = removed.begin(), end = removed.end();
-	while (beg != end) nodes.erase(*(beg++));
 }
 bool MSG_Tester::is_killed(const MSG_Node & node, const TestSet & tests) {
 	if (node.get_score_degree() == 0) return false;
@@ -1191,7 +1754,7 @@ double MSG_Tester::eval_score(const TestSet & tests) {
 		MSG_Node & node = graph->get_node(k);
 		if (node.get_score_degree() == 0) continue;
 
-		size_t num = node.get_mutants().number_of_mutants();
+		size_t num = node.size();
 		total += num; 
 		if (is_killed(node, tests)) killed += num;
 	}
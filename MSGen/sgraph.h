@@ -13,6 +13,8 @@
 */
 
 #include "cscore.h"
+#include "bitindex.h"
+#include "bitmatrix.h"
 #include <set>
 #include <queue>
 
@@ -48,13 +50,15 @@ private:
 /* set of edges from | to a node in MSG */
 class MSG_Port {
 protected:
-	/* create an empty collection for edges from | to a node in MSG */
-	MSG_Port() : edges() {}
-	/* deconstructor */
-	~MSG_Port();
+	/* create an empty collection for edges (in arena of the graph) from | to a node in MSG */
+	MSG_Port(MemoryArena & a) : arena(a), edges(ArenaAllocator<MSG_Edge *>(&a)) {}
+	/* deconstructor (edges are released with arena) */
+	~MSG_Port() {}
 
 	/* create an edge from x to y */
 	bool link(MSG_Node &, MSG_Node &);
+	/* delete the edge from x to y (false if not in port) */
+	bool unlink(MSG_Node &, MSG_Node &);
 
 public:
 	/* number of edges in the port */
@@ -65,19 +69,23 @@ public:
 	/* create and delete */
 	friend class MSG_Node;
 private:
-	std::vector<MSG_Edge *> edges;
+	/* arena where edges are created */
+	MemoryArena & arena;
+	std::vector<MSG_Edge *, ArenaAllocator<MSG_Edge *>> edges;
 };
 
 /* node in MSG */
 class MSG_Node {
 protected:
-	/* create an empty node with none mutants in the graph */
-	MSG_Node(MS_Graph &, long, const BitSeq &);
-	/* deconstructor */
-	~MSG_Node();
+	/* create an empty node with none mutants in the graph, whose vector, mutants and ports are kept in arena */
+	MSG_Node(MS_Graph &, long, const BitSeq &, MemoryArena &);
+	/* deconstructor (never called as node is released with arena of graph) */
+	~MSG_Node() {}
 
 	/* create an edge from this node to the target one */
 	bool link_to(MSG_Node &);
+	/* delete the edge from this node to the target one */
+	bool unlink_to(MSG_Node &);
 
 public:
 	/* get the graph where the node is defined */
@@ -85,10 +93,14 @@ public:
 	/* get the integer id of this node in graph */
 	inline long get_node_id() const { return id; }
 
-	/* get the mutants belong to this node */
-	inline MutantSet & get_mutants() const { return *mutants; }
+	/* get the set of mutants belong to this node (created on demand) */
+	inline const MutantSet & get_mutants() const { return mutants.get_set(); }
+	/* get the ids of mutants belong to this node */
+	inline const MutantList & get_mutant_list() const { return mutants; }
 	/* whether the mutant is in this node */
-	inline bool has_mutant(Mutant::ID mid) const { return mutants->has_mutant(mid); }
+	inline bool has_mutant(Mutant::ID mid) const { return mutants.has_mutant(mid); }
+	/* get the number of mutants in this node */
+	inline size_t size() const { return mutants.number_of_mutants(); }
 
 	/* score vector for mutants in this node */
 	inline const BitSeq & get_score_vector() const { return score_vector; }
@@ -98,7 +110,7 @@ public:
 	inline const MSG_Port & get_in_port() const { return in_port; }
 	inline const MSG_Port & get_ou_port() const { return ou_port; }
 
-	/* create | delete | link_to */
+	/* create | delete | link_to | unlink_to */
 	friend class MS_Graph;
 
 private:
@@ -107,7 +119,7 @@ private:
 	/* node id */
 	long id;
 	/* mutants belong to this node */
-	MutantSet * mutants;
+	MutantList mutants;
 
 	/* edges out from this node */
 	MSG_Port ou_port;
@@ -123,7 +135,7 @@ private:
 class MS_Graph {
 public:
 	/* create an empty MSG */
-	MS_Graph(MutantSpace & space) : mspace(space), nodes(), mut_node() {}
+	MS_Graph(MutantSpace & space) : mspace(space), arena(), nodes(), mut_node(), revision(0) {}
 	/* deconstructor */
 	~MS_Graph() { clear(); }
 
@@ -133,9 +145,13 @@ public:
 	size_t size() const { return nodes.size(); }
 	/* get the number of mutants in the graph */
 	size_t size_of_mutants() const { return mut_node.size(); }
+	/* get the number of times that nodes are created, deleted or renumbered (to validate caches by node id) */
+	size_t get_revision() const { return revision; }
 
 	/* get the node by its id in the graph */
 	MSG_Node & get_node(long) const;
+	/* get the index from mutant to its node */
+	const std::map<Mutant::ID, MSG_Node *> & get_index() const { return mut_node; }
 	/* whether there is node for the mutant in the graph */
 	bool has_node_of(Mutant::ID mid) const { return mut_node.count(mid) > 0; }
 	/* get the node to which the mutant belongs */
@@ -147,20 +163,58 @@ public:
 	bool add_mutant(MSG_Node &, Mutant::ID);
 	/* connect the edge from source to target */
 	void connect(MSG_Node & x, MSG_Node & y) { x.link_to(y); }
-	/* delete all the nodes and edges in the graph */
+	/* delete all the nodes and edges in the graph (by releasing its arena at once) */
 	bool clear();
 
+	/* 
+	*	rebuild this graph as the sub-graph of parent (in the same space) induced by the mutants,
+	*	where the edges are the transitive reduction of parent's subsumption between the nodes
+	*	left, so that no score vectors are compared.
+	*/
+	bool induce(const MS_Graph &, const MutantSet &);
+
+	/*
+	*	insert the mutant into the built graph: it joins the node of the same vector,
+	*	or a new node is linked from its direct subsumers to its direct subsumeds, which
+	*	are searched (by degree) in the existing graph as MSG_Build_Fast does.
+	*/
+	MSG_Node & insert_mutant(Mutant::ID, const BitSeq &);
+	/*
+	*	remove the mutant from the graph, and delete its node when it becomes empty,
+	*	with its parents linked to its children unless subsumed by another child. 
+	*	The last node then takes the id of the deleted one, so that the ids held out
+	*	of graph (e.g. in MSG_Relation or as FrozenMSG's origins) are out of date,
+	*	which is told by get_revision(). Return whether deleted.
+	*/
+	bool remove_mutant(Mutant::ID);
+
 private:
 	MutantSpace & mspace;
+	/* memory of nodes, edges, and their vectors, mutants and ports */
+	MemoryArena arena;
 	std::vector<MSG_Node *> nodes;
 	std::map<Mutant::ID, MSG_Node *> mut_node;
+	/* number of times that nodes are created, deleted or renumbered */
+	size_t revision;
+
+	/* nodes of higher degree directly subsumed by the vector, searched from roots */
+	void search_subsumeds(const BitSeq &, std::vector<MSG_Node *> & DS) const;
+	/* nodes of lower (or equal) degree directly subsuming the vector, searched from leafs */
+	void search_subsumings(const BitSeq &, std::vector<MSG_Node *> & DP) const;
+	/* whether none of the parents of y are left in the visit space VS */
+	bool available_topdown(MSG_Node & y, const std::vector<char> & VS) const;
+	/* whether none of the children of y are left in the visit space VS */
+	bool available_downtop(MSG_Node & y, const std::vector<char> & VS) const;
+	/* remove the node without edges (its memory is kept till clear), and move the last node to its id */
+	void delete_node(MSG_Node &);
 };
 
 /* implement algorithm to construct MSG */
 class MSG_Build {
 protected:
 	/* constructor */
-	MSG_Build(MS_Graph & g) : graph(g), producer(nullptr), consumer(nullptr) {}
+	MSG_Build(MS_Graph & g) : graph(g), producer(nullptr), consumer(nullptr), 
+		strategy(BitIndex::trie), cluster_statistics() {}
 
 	/* graph to be constructed */
 	MS_Graph & graph;
@@ -168,6 +222,10 @@ protected:
 	ScoreProducer * producer;
 	/* consumer for score vector */
 	ScoreConsumer * consumer;
+	/* strategy to cluster indistinguishable mutants */
+	BitIndex::Strategy strategy;
+	/* statistics of the index in the last clustering */
+	BitIndex::Statistics cluster_statistics;
 
 	/* abstract method to build up MSG */
 	virtual bool construct() {
@@ -191,6 +249,11 @@ public:
 	void close();
 	/* build up the graph under construction from score vectors */
 	bool build();
+
+	/* set the strategy to cluster mutants (trie by default) */
+	void set_clustering(BitIndex::Strategy s) { strategy = s; }
+	/* get the statistics of index in the last clustering */
+	const BitIndex::Statistics & get_clustering_statistics() const { return cluster_statistics; }
 };
 /* exhaustive algorithm implement: this will not construct the graph but only evaluate its performance! */
 class MSG_Build_Exhaustive : public MSG_Build {
@@ -260,7 +323,8 @@ private:
 class MSG_Build_Fast : public MSG_Build {
 public:
 	/* constructor */
-	MSG_Build_Fast(MS_Graph & g) : MSG_Build(g) {}
+	MSG_Build_Fast(MS_Graph & g) : MSG_Build(g), base(), roots(), leafs(), 
+		in_base(), erased(), records(), round(0), queue(), answers() {}
 	/* deconstructor */
 	~MSG_Build_Fast() { }
 
@@ -273,33 +337,75 @@ protected:
 	/* ranking clusters based on their degree */
 	bool rankByDegree(std::vector<std::set<MSG_Node *> *> & H);
 	/* compute the nodes directly subsumed by x in base and put them into DS */
-	bool directSubsumed(MSG_Node & x, const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & DS);
+	bool directSubsumed(MSG_Node & x, std::vector<MSG_Node *> & DS);
 
 private:
-	bool directSubsumed_topdown(MSG_Node & x, const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & DS);
-	bool directSubsumed_downtop(MSG_Node & x, const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & DS);
-	bool directSubsumed_randomy(MSG_Node & x, const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & DS);
-	bool purify_subsumeds(std::set<MSG_Node *> & DS);
+	/* nodes linked in graph (of higher degree than those being linked) */
+	std::vector<MSG_Node *> base;
+	/* nodes in base without parents | children */
+	std::vector<MSG_Node *> roots, leafs;
+	/* whether node of each id is in base */
+	std::vector<char> in_base;
+	/* node of each id has left the visit space when its stamp is round */
+	std::vector<size_t> erased;
+	/* node of each id has been put in queue when its stamp is round */
+	std::vector<size_t> records;
+	/* stamp of current traversal (so that arrays are not cleared for each node) */
+	size_t round;
+	/* nodes to be visited (reused by each traversal) */
+	std::vector<MSG_Node *> queue;
+	/* DS of each node in current level */
+	std::vector<std::vector<MSG_Node *>> answers;
+
+	/* whether node y is in the visit space of current traversal */
+	bool in_space(const MSG_Node & y) const { 
+		return in_base[y.get_node_id()] && erased[y.get_node_id()] != round; 
+	}
+	/* remove node y from the visit space of current traversal */
+	void erase(const MSG_Node & y) { erased[y.get_node_id()] = round; }
+
+	bool directSubsumed_topdown(MSG_Node & x, std::vector<MSG_Node *> & DS);
+	bool directSubsumed_downtop(MSG_Node & x, std::vector<MSG_Node *> & DS);
+	bool directSubsumed_randomy(MSG_Node & x, std::vector<MSG_Node *> & DS);
+	bool purify_subsumeds(std::vector<MSG_Node *> & DS);
 
-	bool derive_roots(const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & roots);
-	bool derive_leafs(const std::set<MSG_Node *> & VS, std::set<MSG_Node *> & leafs);
+	/* derive roots and leafs of base */
+	bool derive_roots_leafs();
 	
-	bool available_topdown(MSG_Node &y, const std::set<MSG_Node *> & VS);
-	bool available_downtop(MSG_Node &y, const std::set<MSG_Node *> & VS);
+	bool available_topdown(MSG_Node &y);
+	bool available_downtop(MSG_Node &y);
 
-	/* remove nodes that subsume y from VS */
-	bool erase_subsuming(MSG_Node & y, std::set<MSG_Node *> & VS);
-	/* remove nodes that are subsumed by y from VS */
-	bool erase_subsumeds(MSG_Node & y, std::set<MSG_Node *> & VS);
+	/* remove nodes that subsume y from visit space */
+	bool erase_subsuming(MSG_Node & y);
+	/* remove nodes that are subsumed by y from visit space */
+	bool erase_subsumeds(MSG_Node & y);
 
 };
+/* partitions of no more clusters are built up sequentially by MSG_Build_Quick */
+static const size_t QUICK_SEQUENTIAL_CUTOFF = 256;
 /* (very) fast algorithm implement: this will update MSG */
 class MSG_Build_Quick : public MSG_Build {
 public:
-	MSG_Build_Quick(MS_Graph & g) : MSG_Build(g), clusters() {}
+	/* option to choose the pivot to classify clusters */
+	typedef char PivotOption;
+	static const PivotOption first_pivot = 0;	/* the first cluster in the set */
+	static const PivotOption median_pivot = 1;	/* the cluster of median score degree */
+
+	MSG_Build_Quick(MS_Graph & g) : MSG_Build(g), clusters(), pivoting(first_pivot), 
+		in_place(false), threads(1), cutoff(QUICK_SEQUENTIAL_CUTOFF), pool(nullptr), array(), connecting() {}
 	/* deconstructor */
 	~MSG_Build_Quick() { clusters.clear(); }
 
+	/* set the option to choose pivot (first_pivot by default) */
+	void set_pivoting(PivotOption option) { pivoting = option; }
+	/* whether to partition one array of clusters in place rather than copying them into sets at each level */
+	void set_in_place(bool option) { in_place = option; }
+	/* 
+	*	set the workers to build up the partitions and to combine them (1 by default, 
+	*	0 for the number of cores), where those of no more than cutoff are sequential.
+	*/
+	void set_parallel(size_t n, size_t limit = QUICK_SEQUENTIAL_CUTOFF) { threads = n; cutoff = limit; }
+
 protected:
 	/* construct the graph */
 	bool construct();
@@ -312,10 +418,34 @@ protected:
 private:
 	/* clusters in graph */
 	std::set<MSG_Node *> clusters;
+	/* option to choose pivot */
+	PivotOption pivoting;
+	/* whether to partition array in place */
+	bool in_place;
+	/* number of workers */
+	size_t threads;
+	/* size of partitions built up sequentially */
+	size_t cutoff;
+	/* workers during linking (null when sequential) */
+	ForkJoinPool * pool;
+	/* clusters partitioned in place */
+	std::vector<MSG_Node *> array;
+	/* edges are created in the arena of graph by one task at a time */
+	std::mutex connecting;
 
 	/* build up local MSG for subset of clusters */
 	bool build_up(const std::set<MSG_Node *> &);
-
+	/* build up local MSG for clusters in array[beg, end) */
+	bool build_up(size_t beg, size_t end);
+	/* connect pivot x with the sub-graphs of S, D and N by their roots and leafs */
+	bool combine(MSG_Node & x, size_t size,
+		const std::vector<MSG_Node *> & sleafs, const std::vector<MSG_Node *> & droots,
+		const std::vector<MSG_Node *> & nroots, const std::vector<MSG_Node *> & nleafs);
+	/* run the tasks by workers when partition of the size is over cutoff, or sequentially */
+	void invoke(std::vector<std::function<void()>> & tasks, size_t size);
+
+	/* choose the pivot in nodes by option */
+	MSG_Node & select_pivot(const std::set<MSG_Node *> & nodes);
 	/* classify the nodes in C to three groups
 		1) S : those subsumes I;
 		2) D : those subsumed by I;
@@ -324,20 +454,28 @@ private:
 	bool classify(const std::set<MSG_Node *> & C, 
 		MSG_Node & I, std::set<MSG_Node *> & S, 
 		std::set<MSG_Node *> & D, std::set<MSG_Node *> & N);
+	/* 
+	*	move the pivot chosen in array[beg, end) to beg, and partition the others into 
+	*	S = [beg + 1, dbeg), D = [dbeg, nbeg) and N = [nbeg, end) around it.
+	*/
+	void partition(size_t beg, size_t end, size_t & dbeg, size_t & nbeg);
 	/* derive roots and leafs in given node set */
 	bool derive_roots_leafs(const std::set<MSG_Node *> & nodes,
-		std::set<MSG_Node *> & roots, std::set<MSG_Node *> & leafs);
+		std::vector<MSG_Node *> & roots, std::vector<MSG_Node *> & leafs);
+	/* derive roots and leafs in array[beg, end) */
+	bool derive_roots_leafs(size_t beg, size_t end,
+		std::vector<MSG_Node *> & roots, std::vector<MSG_Node *> & leafs);
 	/* combine A to B by giving A's leafs and B's roots 
 		1) DS: direct subsumption from node in A to those in B
 	*/
-	bool combine_LR(const std::set<MSG_Node *> & aleafs, 
-		const std::set<MSG_Node *> & broots, 
+	bool combine_LR(const std::vector<MSG_Node *> & aleafs, 
+		const std::vector<MSG_Node *> & broots, 
 		std::map<MSG_Node *, std::set<MSG_Node *> *> & DS);
 
 	/* whether the next node can be accessed given its visited records */
 	bool topdown_ready(MSG_Node & next, const std::set<MSG_Node *> & visits);
 	/* derive nodes directly subsumed by source in graph without considering its self-subsumption or by its existing children */
-	bool derive_direct_subsumed(MSG_Node & source, const std::set<MSG_Node *> &troots, std::set<MSG_Node *> & DS);
+	bool derive_direct_subsumed(MSG_Node & source, const std::vector<MSG_Node *> &troots, std::set<MSG_Node *> & DS);
 	/* update the directly subsumed ones to the true answers */
 	bool update_direct_subsumed(MSG_Node & source, std::set<MSG_Node *> & DS);
 	/* delete those in DS that are subsumed by another one in DS */
@@ -345,17 +483,85 @@ private:
 
 };
 
+/*
+*	incremental MSG maintained as tests are applied one by one: a new test splits
+*	the clusters it distinguishes (partition refinement) and only repairs edges of
+*	clusters it kills, while removing a test merges the clusters it distinguished.
+*	Bit k of the score vectors refers to the k-th applied test in get_tests().
+*/
+class MSG_Refiner {
+public:
+	/* all mutants in the set are indistinguishable before any test is applied */
+	MSG_Refiner(const MutantSet &);
+	/* continue from a built graph, where bit k of its score vectors refers to the kth test */
+	MSG_Refiner(const MS_Graph &, const std::vector<TestCase::ID> &);
+	/* deconstructor */
+	~MSG_Refiner() { clear(); }
+
+	/* get the space of mutants */
+	MutantSpace & get_space() const { return mspace; }
+	/* tests applied (in order of bits in score vectors) */
+	const std::vector<TestCase::ID> & get_tests() const { return tests; }
+	/* number of clusters of indistinguishable mutants */
+	size_t number_of_clusters() const { return clusters.size(); }
+	/* number of direct subsumption edges between clusters */
+	size_t number_of_edges() const { return edges; }
+
+	/* apply the test, where column[mid] is 1 when mutant is killed by it */
+	void add_test(TestCase::ID, const BitSeq & column);
+	/* remove the applied test and merge the clusters only it distinguishes (false if not applied) */
+	bool remove_test(TestCase::ID);
+	/* write the clusters and edges into the (cleared) graph of the same space */
+	void write(MS_Graph &) const;
+	/*
+	*	apply the columns of kills (mutant x test) by order, and print the number
+	*	of tests, clusters and edges after each one as the evolution curve.
+	*/
+	void evolve(const BitMatrix & kills, const std::vector<TestCase::ID> & order, std::ostream &);
+
+private:
+	/* cluster of mutants with the same score vector */
+	struct Cluster {
+		/* score vector over applied tests (bits over them are zeros) */
+		BitSeq vector;
+		/* number of tests killing the mutants */
+		BitSeq::size_t degree;
+		/* mutants in the cluster */
+		std::vector<Mutant::ID> mutants;
+		/* clusters directly subsumed by this one */
+		std::vector<unsigned int> nexts;
+
+		Cluster(BitSeq::size_t width) : vector(width), degree(0), mutants(), nexts() {}
+	};
+
+	/* space of mutants */
+	MutantSpace & mspace;
+	/* tests applied by order */
+	std::vector<TestCase::ID> tests;
+	/* bits reserved in score vectors (doubled when tests exceed it) */
+	BitSeq::size_t width;
+	/* clusters in the graph */
+	std::vector<Cluster *> clusters;
+	/* number of edges */
+	size_t edges;
+
+	/* split clusters by the test killing mutants of 1 in column[0, bits) and repair the edges */
+	void refine(TestCase::ID, const word * column, size_t bits);
+	/* recompute the direct subsumption between clusters */
+	void relink();
+	/* delete all clusters */
+	void clear();
+};
+
 /* pair of node for relating nodes */
 class MSG_Pair {
 public:
 	/* create a pair from source node to target node */
-	MSG_Pair(MSG_Node & s, MSG_Node & t) : src(s), trg(t) {
-		mutants = s.get_graph().get_space().create_set();
-	}
+	MSG_Pair(MSG_Node & s, MSG_Node & t) : src(s), trg(t), mutants(s.get_graph().get_space()) {}
 	/* deconstructor */
-	~MSG_Pair() { mutants->get_space().delete_set(mutants); }
+	~MSG_Pair() {}
 	/* add mutant that belong to both nodes in the pair */
-	void add_mutant(Mutant::ID mid) { mutants->add_mutant(mid); }
+	void add_mutant(Mutant::ID mid) { mutants.add_mutant(mid); }
 
 public:
 	/* get source node */
@@ -364,11 +570,13 @@ public:
 	MSG_Node & get_target() const { return trg; }
 
 	/* whether the mutant belongs to both nodes in this pair */
-	bool has_mutant(Mutant::ID mid) const { return mutants->has_mutant(mid); }
+	bool has_mutant(Mutant::ID mid) const { return mutants.has_mutant(mid); }
 	/* get the number of mutants belong to both nodes in this pair */
-	size_t size_of() const { return mutants->number_of_mutants(); }
-	/* get the set of mutants in this pair */
-	const MutantSet & get_mutants() const { return *mutants; }
+	size_t size_of() const { return mutants.number_of_mutants(); }
+	/* get the set of mutants in this pair (created on demand) */
+	const MutantSet & get_mutants() const { return mutants.get_set(); }
+	/* get the ids of mutants in this pair */
+	const MutantList & get_mutant_list() const { return mutants; }
 	
 	/* create | delete | add_mutant */
 	friend class MSG_Relation;
@@ -378,8 +586,8 @@ private:
 	MSG_Node & src;
 	/* node in target graph */
 	MSG_Node & trg;
-	/* set of mutants belonging to both nodes */
-	MutantSet * mutants;
+	/* mutants belonging to both nodes */
+	MutantList mutants;
 };
 /* relations between two graphs */
 class MSG_Relation {
@@ -422,7 +630,7 @@ private:
 /* To generate minimal tests for given mutants in MSG */
 class MSG_Tester {
 public:
-	MSG_Tester() : graph(nullptr) {}
+	MSG_Tester() : graph(nullptr), kills(nullptr), revision(0) {}
 	~MSG_Tester() { close(); }
 
 	void open(MS_Graph & g) { close(); graph = &g; }
@@ -430,10 +638,21 @@ public:
 	void gen_tests(const std::set<MSG_Node *> & msnodes, TestSet & tests);
 	double eval_score(const TestSet & tests);
 	double eval_dom_score(const TestSet & tests);
-	void close() { graph = nullptr; }
+	void close() { 
+		graph = nullptr; 
+		if (kills != nullptr) delete kills;
+		kills = nullptr;
+	}
 
 private:
 	MS_Graph * graph;
+	/* nodes (by id) x tests, whose columns give the nodes killed by each test */
+	BitMatrix * kills;
+	/* revision of graph when the kill matrix is built */
+	size_t revision;
+
+	/* get the kill matrix of nodes in graph (rebuilt when the nodes are updated) */
+	const BitMatrix & get_kill_matrix();
 
 protected:
 	void eliminate(TestCase::ID tid, std::set<MSG_Node *> & nodes);
@@ -33,7 +33,7 @@ void MutGroup::classify() {
 		while (beg != end) subsumings.insert(*(beg++));
 	}
 	else {
-		const std::vector<MuSubsume> & edges 
+		const MuSubsumePort::EdgeList & edges 
 			= equivalents->get_ou_port().get_edges();
 		auto ebeg = edges.begin(), eend = edges.end();
 		while (ebeg != eend) {
@@ -126,7 +126,7 @@ void MutLevel::end() {
 		auto cend = subsuming_clusters.end();
 		while (cbeg != cend) {
 			MuCluster * cluster = *(cbeg++);
-			if (cluster->get_mutants().number_of_mutants() != 0) {
+			if (cluster->size() != 0) {
 				Mutant::ID mid = get_mutant_of(*cluster);
 				const BitSeq & svec = cluster->get_score_vector();
 				global_group->add_mutant(mid, svec);
@@ -149,13 +149,9 @@ void MutLevel::clear() {
 	operator_groups.clear();
 }
 Mutant::ID MutLevel::get_mutant_of(const MuCluster & cluster) {
-	const MutantSet & mutants = cluster.get_mutants();
-	Mutant::ID mid = 0, num = mspace.number_of_mutants();
-	while (mid < num) {
-		if (mutants.has_mutant(mid))
-			return mid;
-		else mid++;
-	}
+	const MutantList & mutants = cluster.get_mutant_list();
+	if (mutants.number_of_mutants() > 0) 
+		return mutants.get_mutant(0);
 
 	CError error(CErrorType::Runtime, 
 		"MutLevel::get_mutant_of", 
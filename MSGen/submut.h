@@ -135,12 +135,15 @@ public:
 
 	/* update the data */
 	void update(ScoreProducer & producer, ScoreConsumer & consumer) {
-		ScoreVector * vector;
+		ScoreBatch * batch;
 		
 		data.clear();
-		while ((vector = producer.produce()) != nullptr) {
-			data.add(vector->get_mutant(), vector->get_vector());
-			consumer.consume(vector);
+		while ((batch = producer.produce_batch()) != nullptr) {
+			for (size_t k = 0; k < batch->size(); k++) {
+				const ScoreVector & vector = batch->get_vector(k);
+				data.add(vector.get_mutant(), vector.get_vector());
+			}
+			consumer.consume_batch(batch);
 		}
 		data.end();
 	}
@@ -20,7 +20,7 @@ MuClusterSet::MuClusterSet(const MSGraph & g) : graph(g) {
 			subsuming_clusters.insert(*(beg++));
 	}
 	else {
-		const std::vector<MuSubsume> & edges = eq_cluster->get_ou_port().get_edges();
+		const MuSubsumePort::EdgeList & edges = eq_cluster->get_ou_port().get_edges();
 		for (int i = 0; i < edges.size(); i++) {
 			const MuSubsume & edge = edges[i];
 			MuCluster * target = &(edge.get_target());
@@ -883,8 +883,8 @@ void TestMachine::generate_by_requirement(TestSet & tests, const std::set<MuClus
 }
 void TestMachine::greedy_generate_tests(TestSet & tests, const std::set<MuCluster *> & RS) {
 	/* initialization */
-	tests.clear(); std::set<MuCluster *> reduced;
-	std::set<MuCluster *> requirements;
+	tests.clear(); std::set<MuCluster *> requirements;
+	const MSGraph & graph = context.get_clusters().get_graph();
 	auto rbeg = RS.begin(), rend = RS.end();
 	while (rbeg != rend)
 		requirements.insert(*(rbeg++));
@@ -907,28 +907,33 @@ void TestMachine::greedy_generate_tests(TestSet & tests, const std::set<MuCluste
 		BitSeq::size_t rand_seed = gen_random_seed(score_deg);
 		TestCase::ID tid = find_test_at(score_set, rand_seed);
 
-		/* update requirement with newly test */
-		reduced.clear();
-		auto beg = requirements.begin();
-		auto end = requirements.end();
+		/* eliminate requirements killed by newly test */
+		const std::vector<unsigned int> & killeds = get_kill_matrix().get_posting(tid);
+		auto beg = killeds.begin(), end = killeds.end();
 		while (beg != end) {
-			MuCluster * req = *(beg++);
-			const BitSeq & tset = req->get_score_vector();
-			if (tset.get_bit(tid) == BIT_1)
-				reduced.insert(req);
+			MuCluster & req = graph.get_cluster(*(beg++));
+			requirements.erase(&req);
 		}
 
-		/* eliminate killed requirements */
-		beg = reduced.begin(), end = reduced.end();
-		while (beg != end)
-			requirements.erase(*(beg++));
-
 		/* add into test set */ tests.add_test(tid);
 
 	} /* end while: kill requirements */
 
 	/* return */ return;
 }
+const BitMatrix & TestMachine::get_kill_matrix() {
+	if (kills == nullptr) {
+		const MSGraph & graph = context.get_clusters().get_graph();
+		MuCluster::ID k, n = graph.size(); size_t tests = 0;
+		if (n > 0) tests = graph.get_cluster(0).get_score_vector().bit_number();
+
+		kills = new BitMatrix(n, tests);
+		for (k = 0; k < n; k++)
+			kills->set_row(k, graph.get_cluster(k).get_score_vector());
+		kills->transpose();
+	}
+	return *kills;
+}
 BitSeq::size_t TestMachine::gen_random_seed(BitSeq::size_t n) {
 	return 0 + std::rand() % n;
 }
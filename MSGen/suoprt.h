@@ -9,6 +9,7 @@
 
 // include list
 #include "mgraph.h"
+#include "bitmatrix.h"
 #include <stack>
 
 // class declarations
@@ -280,9 +281,9 @@ protected:
 class TestMachine {
 public:
 	/* create a closed machine for test generation */
-	TestMachine(const SOperatorSet & ctxt) : context(ctxt) {}
+	TestMachine(const SOperatorSet & ctxt) : context(ctxt), kills(nullptr) {}
 	/* deconstructor */
-	~TestMachine() {}
+	~TestMachine() { if (kills != nullptr) delete kills; }
 
 	/* generate a minimal test set for subsuming mutants in given operators */
 	void generate_by_operators(TestSet &, const std::set<std::string> &);
@@ -297,6 +298,11 @@ public:
 private:
 	/* context for test generation */
 	const SOperatorSet & context;
+	/* clusters (by id) x tests, whose columns give the clusters killed by each test */
+	BitMatrix * kills;
+
+	/* get the kill matrix of clusters in context (built at first access) */
+	const BitMatrix & get_kill_matrix();
 
 	/* generate a random index in [0, n - 1] */
 	BitSeq::size_t gen_random_seed(BitSeq::size_t);